@@ -12,9 +12,13 @@ int rapidyenc_version(void) {
 	return RAPIDYENC_VERSION;
 }
 
+// for combined encode/decode + CRC32 functions: amount of data to process before hashing it; this needs to be small enough for the data to still be in L2 cache when it is read the second time, but large enough to amortise per-call overheads
+#define CRC_BLOCK_SIZE 65536
+
 #ifndef RAPIDYENC_DISABLE_ENCODE
 
 #include "src/encoder.h"
+#include <string.h>
 void rapidyenc_encode_init(void) {
 	static int done = 0;
 	if(done) return;
@@ -32,17 +36,119 @@ size_t rapidyenc_encode_ex(int line_size, int* column, const void* __restrict sr
 	return RapidYenc::encode(line_size, column, src, dest, src_length, is_end);
 }
 
+size_t rapidyenc_encode_bounded(int line_size, int* column, const void* __restrict src, void* __restrict dest, size_t src_length, int is_end, size_t dest_capacity, size_t* src_consumed) {
+	int unusedColumn = 0;
+	if(!column) column = &unusedColumn;
+	
+	const unsigned char* in = (const unsigned char*)src;
+	unsigned char* out = (unsigned char*)dest;
+	unsigned char* outEnd = out + dest_capacity;
+	size_t remaining = src_length;
+	// encode as much as is guaranteed to fit; this is most of the input, until the end of `dest` gets close
+	while(remaining) {
+		size_t space = outEnd - out;
+		size_t amount = remaining;
+		if(amount > space/2) amount = space/2;
+		while(amount) {
+			size_t maxLen = rapidyenc_encode_max_length(amount, line_size);
+			if(maxLen <= space) break;
+			// the max length shrinks by at least 2 bytes for every byte removed from the input
+			size_t reduce = (maxLen - space + 1) / 2;
+			amount = reduce < amount ? amount - reduce : amount / 2;
+		}
+		if(!amount) break;
+		out += RapidYenc::encode(line_size, column, in, out, amount, is_end && amount == remaining);
+		in += amount;
+		remaining -= amount;
+	}
+	// not enough space to guarantee that any more input fits, so encode into a temporary buffer and only keep what fits
+	while(remaining) {
+		unsigned char tmp[512];
+		size_t space = outEnd - out;
+		if(!space) break;
+		size_t amount = remaining < space ? remaining : space;
+		// at short line lengths, each input byte can expand to several output bytes, so limit the input to what's guaranteed to fit in `tmp`; rapidyenc_encode_max_length(1, ...) always does
+		while(amount > 1 && rapidyenc_encode_max_length(amount, line_size) > sizeof(tmp))
+			amount /= 2;
+		size_t len;
+		int col;
+		while(1) {
+			col = *column;
+			len = RapidYenc::encode(line_size, &col, in, tmp, amount, is_end && amount == remaining);
+			if(len <= space || amount == 1) break;
+			amount = (amount+1) / 2;
+		}
+		if(len > space) break;
+		memcpy(out, tmp, len);
+		out += len;
+		*column = col;
+		in += amount;
+		remaining -= amount;
+	}
+	
+	*src_consumed = in - (const unsigned char*)src;
+	return out - (unsigned char*)dest;
+}
+
+size_t rapidyenc_encode_length(int line_size, int* column, const void* src, size_t src_length, int is_end) {
+	int unusedColumn = 0;
+	if(!column) column = &unusedColumn;
+	return RapidYenc::encode_length(line_size, column, src, src_length, is_end);
+}
+
+size_t rapidyenc_encode_parallel(int line_size, int* column, const void* __restrict src, void* __restrict dest, size_t src_length, int is_end, size_t num_chunks, RapidYencTaskRunner runner, void* pool) {
+	int unusedColumn = 0;
+	if(!column) column = &unusedColumn;
+	return RapidYenc::encode_parallel(line_size, column, src, dest, src_length, is_end, num_chunks, (RapidYenc::task_runner)runner, pool);
+}
+
+size_t rapidyenc_encode_iov(int line_size, int* column, const RapidYencIovec* src, size_t src_count, void* __restrict dest, int is_end) {
+	int unusedColumn = 0;
+	if(!column) column = &unusedColumn;
+	return RapidYenc::encode_iov(line_size, column, (const RapidYenc::iovec_segment*)src, src_count, dest, is_end);
+}
+
+size_t rapidyenc_encode_batch(int line_size, RapidYencEncodeJob* jobs, size_t num_jobs) {
+	return RapidYenc::encode_batch(line_size, (RapidYenc::encode_job*)jobs, num_jobs);
+}
+
+#ifndef RAPIDYENC_DISABLE_CRC
+#include "src/crc.h"
+
+size_t rapidyenc_encode_crc_ex(int line_size, int* column, const void* __restrict src, void* __restrict dest, size_t src_length, int is_end, uint32_t* crc) {
+	int unusedColumn = 0;
+	if(!column) column = &unusedColumn;
+	
+	const unsigned char* in = (const unsigned char*)src;
+	unsigned char* out = (unsigned char*)dest;
+	uint32_t crcValue = *crc;
+	while(src_length > CRC_BLOCK_SIZE) {
+		out += RapidYenc::encode(line_size, column, in, out, CRC_BLOCK_SIZE, 0);
+		crcValue = RapidYenc::crc32(in, CRC_BLOCK_SIZE, crcValue);
+		in += CRC_BLOCK_SIZE;
+		src_length -= CRC_BLOCK_SIZE;
+	}
+	out += RapidYenc::encode(line_size, column, in, out, src_length, is_end);
+	*crc = RapidYenc::crc32(in, src_length, crcValue);
+	return out - (unsigned char*)dest;
+}
+#endif
+
 int rapidyenc_encode_kernel() {
 	return RapidYenc::encode_isa_level();
 }
 
+int rapidyenc_encode_set_kernel(int kernel) {
+	return RapidYenc::encoder_set_kernel(kernel) ? 1 : 0;
+}
+
 #endif // !defined(RAPIDYENC_DISABLE_ENCODE)
 
 size_t rapidyenc_encode_max_length(size_t length, int line_size) {
 	size_t ret = length * 2    /* all characters escaped */
 		+ 2 /* allocation for offset and that a newline may occur early */
 #if !defined(YENC_DISABLE_AVX256)
-		+ 64 /* allocation for YMM overflowing */
+		+ 128 /* allocation for YMM/ZMM overflowing */
 #else
 		+ 32 /* allocation for XMM overflowing */
 #endif
@@ -74,16 +180,118 @@ size_t rapidyenc_decode_ex(int is_raw, const void* src, void* dest, size_t src_l
 	return RapidYenc::decode(is_raw, src, dest, src_length, (RapidYenc::YencDecoderState*)state);
 }
 
+size_t rapidyenc_decode_parallel(int is_raw, const void* src, void* dest, size_t src_length, RapidYencDecoderState* state, size_t num_chunks, RapidYencTaskRunner runner, void* pool) {
+	RapidYencDecoderState unusedState = RYDEC_STATE_CRLF;
+	if(!state) state = &unusedState;
+	return RapidYenc::decode_parallel(is_raw, src, dest, src_length, (RapidYenc::YencDecoderState*)state, num_chunks, (RapidYenc::task_runner)runner, pool);
+}
+
+size_t rapidyenc_decode_iov(int is_raw, const RapidYencIovec* src, size_t src_count, void* dest, RapidYencDecoderState* state) {
+	RapidYencDecoderState unusedState = RYDEC_STATE_CRLF;
+	if(!state) state = &unusedState;
+	return RapidYenc::decode_iov(is_raw, (const RapidYenc::iovec_segment*)src, src_count, dest, (RapidYenc::YencDecoderState*)state);
+}
+
 RapidYencDecoderEnd rapidyenc_decode_incremental(const void** src, void** dest, size_t src_length, RapidYencDecoderState* state) {
 	RapidYencDecoderState unusedState = RYDEC_STATE_CRLF;
 	if(!state) state = &unusedState;
 	return (RapidYencDecoderEnd)RapidYenc::decode_end(src, dest, src_length, (RapidYenc::YencDecoderState*)state);
 }
 
+RapidYencDecoderEnd rapidyenc_decode_ring(const void* ring, size_t mask, size_t head, size_t tail, void* dest, size_t* consumed, size_t* produced, RapidYencDecoderState* state) {
+	RapidYencDecoderState unusedState = RYDEC_STATE_CRLF;
+	if(!state) state = &unusedState;
+	void* out = dest;
+	RapidYencDecoderEnd ended = (RapidYencDecoderEnd)RapidYenc::decode_end_ring(ring, mask, head, tail, &out, consumed, (RapidYenc::YencDecoderState*)state);
+	*produced = (char*)out - (char*)dest;
+	return ended;
+}
+
+size_t rapidyenc_decode_ring_alignment(void) {
+	return RapidYenc::decode_width();
+}
+
+RapidYencArticleResult rapidyenc_decode_article(const void* src, size_t src_length, void* dest, RapidYencArticle* article) {
+	return (RapidYencArticleResult)RapidYenc::decode_article(src, src_length, dest, (RapidYenc::yenc_article*)article);
+}
+
+void rapidyenc_nntp_reader_init(RapidYencNntpReader* reader) {
+	RapidYenc::nntp_reader_init((RapidYenc::nntp_reader*)reader);
+}
+size_t rapidyenc_nntp_split(RapidYencNntpReader* reader, const void* src, size_t src_length, void* dest, RapidYencNntpResponse* responses, size_t max_responses, size_t* src_consumed) {
+	return RapidYenc::nntp_split((RapidYenc::nntp_reader*)reader, src, src_length, dest, (RapidYenc::nntp_response*)responses, max_responses, src_consumed);
+}
+
+#ifndef RAPIDYENC_DISABLE_CRC
+#include "src/crc.h"
+static RapidYenc::YencDecoderEnd decode_end_crc(const void** src, void** dest, size_t src_length, RapidYenc::YencDecoderState* state, uint32_t* crc) {
+	uint32_t crcValue = *crc;
+	RapidYenc::YencDecoderEnd ended = RapidYenc::YDEC_END_NONE;
+	while(src_length) {
+		size_t blockLen = src_length > CRC_BLOCK_SIZE ? CRC_BLOCK_SIZE : src_length;
+		const unsigned char* outStart = (const unsigned char*)*dest;
+		ended = RapidYenc::decode_end(src, dest, blockLen, state);
+		crcValue = RapidYenc::crc32(outStart, (const unsigned char*)*dest - outStart, crcValue);
+		if(ended != RapidYenc::YDEC_END_NONE) break;
+		src_length -= blockLen;
+	}
+	*crc = crcValue;
+	return ended;
+}
+
+RapidYencDecoderEnd rapidyenc_decode_incremental_crc(const void** src, void** dest, size_t src_length, RapidYencDecoderState* state, uint32_t* crc) {
+	RapidYencDecoderState unusedState = RYDEC_STATE_CRLF;
+	if(!state) state = &unusedState;
+	return (RapidYencDecoderEnd)decode_end_crc(src, dest, src_length, (RapidYenc::YencDecoderState*)state, crc);
+}
+
+RapidYencVerifyResult rapidyenc_decode_article_verify(const void* src, size_t src_length, void* dest, RapidYencArticle* article, uint32_t* crc) {
+	RapidYencArticle unusedArticle;
+	if(!article) article = &unusedArticle;
+	RapidYenc::yenc_article* art = (RapidYenc::yenc_article*)article;
+	uint32_t crcValue = 0;
+	if(crc) *crc = 0;
+	
+	RapidYenc::YencArticleResult result = RapidYenc::decode_article_header(src, src_length, art);
+	if(result == RapidYenc::YART_OK) {
+		const void* in = (const char*)src + art->dataOffset;
+		void* out = (char*)dest + art->dataOffset;
+		RapidYenc::YencDecoderState state = RapidYenc::YDEC_STATE_CRLF;
+		RapidYenc::YencDecoderEnd ended = decode_end_crc(&in, &out, src_length - art->dataOffset, &state, &crcValue);
+		art->dataLength = (char*)out - ((char*)dest + art->dataOffset);
+		if(crc) *crc = crcValue;
+		result = RapidYenc::decode_article_trailer(src, src_length, in, ended, art);
+	}
+	// this includes an unterminated =yend line, whose CRC may be missing or incomplete
+	if(result == RapidYenc::YART_TRUNCATED) return RYVERIFY_TRUNCATED;
+	if(result != RapidYenc::YART_OK) return RYVERIFY_MALFORMED;
+	
+	if(art->dataLength != art->endSize)
+		return RYVERIFY_SIZE_MISMATCH;
+	if(art->flags & YART_FLAG_PART) {
+		if(art->partEnd < art->partBegin || art->partEnd - art->partBegin + 1 != art->dataLength)
+			return RYVERIFY_SIZE_MISMATCH;
+	} else if(art->dataLength != art->size)
+		return RYVERIFY_SIZE_MISMATCH;
+	
+	// pcrc32 covers this part; crc32 covers the whole file, which is only this part for single-part articles
+	if(art->flags & YART_FLAG_PCRC32) {
+		if(art->pcrc32 != crcValue) return RYVERIFY_CRC_MISMATCH;
+	} else if(!(art->flags & YART_FLAG_PART) && (art->flags & YART_FLAG_CRC32)) {
+		if(art->crc32 != crcValue) return RYVERIFY_CRC_MISMATCH;
+	}
+	return RYVERIFY_OK;
+}
+#endif
+
 int rapidyenc_decode_kernel() {
 	return RapidYenc::decode_isa_level();
 }
 
+int rapidyenc_decode_set_kernel(int kernel) {
+	return RapidYenc::decoder_set_kernel(kernel) ? 1 : 0;
+}
+
 #endif // !defined(RAPIDYENC_DISABLE_DECODE)
 
 #ifndef RAPIDYENC_DISABLE_CRC
@@ -99,9 +307,30 @@ void rapidyenc_crc_init(void) {
 uint32_t rapidyenc_crc(const void* src, size_t src_length, uint32_t init_crc) {
 	return RapidYenc::crc32(src, src_length, init_crc);
 }
+void rapidyenc_crc_multi(const void** src, const size_t* src_length, uint32_t* crcs, size_t count) {
+	RapidYenc::crc32_multi(src, src_length, crcs, count);
+}
+uint32_t rapidyenc_crc_parallel(const void* src, size_t src_length, uint32_t init_crc, size_t num_chunks, RapidYencTaskRunner runner, void* pool) {
+	return RapidYenc::crc32_parallel(src, src_length, init_crc, num_chunks, (RapidYenc::task_runner)runner, pool);
+}
+uint32_t rapidyenc_crc_blocks(const void* src, size_t src_length, size_t block_size, uint32_t* block_crcs) {
+	return RapidYenc::crc32_blocks(src, src_length, block_size, block_crcs);
+}
+void rapidyenc_crc_rolling_init(RapidYencCrcRolling* state, size_t window_size) {
+	RapidYenc::crc32_rolling_init((RapidYenc::crc_rolling*)state, window_size);
+}
+uint32_t rapidyenc_crc_roll(const RapidYencCrcRolling* state, uint32_t crc, uint8_t byte_out, uint8_t byte_in) {
+	return RapidYenc::crc32_roll((const RapidYenc::crc_rolling*)state, crc, byte_out, byte_in);
+}
+size_t rapidyenc_crc_rolling_search(const RapidYencCrcRolling* state, const void* src, size_t src_length, const uint32_t* targets, size_t num_targets, RapidYencCrcMatch* matches, size_t max_matches) {
+	return RapidYenc::crc32_rolling_search((const RapidYenc::crc_rolling*)state, src, src_length, targets, num_targets, (RapidYenc::crc_rolling_match*)matches, max_matches);
+}
 uint32_t rapidyenc_crc_combine(uint32_t crc1, const uint32_t crc2, uint64_t length2) {
 	return RapidYenc::crc32_combine(crc1, crc2, length2);
 }
+void rapidyenc_crc_combine_many(const uint32_t* crc1, const uint32_t* crc2, const uint64_t* length2, uint32_t* out, size_t count) {
+	RapidYenc::crc32_combine_many(crc1, crc2, length2, out, count);
+}
 uint32_t rapidyenc_crc_zeros(uint32_t init_crc, uint64_t length) {
 	return RapidYenc::crc32_zeros(init_crc, length);
 }
@@ -117,10 +346,39 @@ uint32_t rapidyenc_crc_2pow(int64_t n) {
 uint32_t rapidyenc_crc_256pow(uint64_t n) {
 	return RapidYenc::crc32_256pow(n);
 }
+void rapidyenc_crc_256pow_many(const uint64_t* n, uint32_t* out, size_t count) {
+	RapidYenc::crc32_256pow_many(n, out, count);
+}
 
 int rapidyenc_crc_kernel() {
 	return RapidYenc::crc32_isa_level();
 }
 
+uint32_t rapidyenc_crc32c(const void* src, size_t src_length, uint32_t init_crc) {
+	return RapidYenc::crc32c(src, src_length, init_crc);
+}
+uint32_t rapidyenc_crc32c_combine(uint32_t crc1, const uint32_t crc2, uint64_t length2) {
+	return RapidYenc::crc32c_combine(crc1, crc2, length2);
+}
+uint32_t rapidyenc_crc32c_zeros(uint32_t init_crc, uint64_t length) {
+	return RapidYenc::crc32c_zeros(init_crc, length);
+}
+uint32_t rapidyenc_crc32c_unzero(uint32_t init_crc, uint64_t length) {
+	return RapidYenc::crc32c_unzero(init_crc, length);
+}
+uint32_t rapidyenc_crc32c_multiply(uint32_t a, uint32_t b) {
+	return RapidYenc::crc32c_multiply(a, b);
+}
+uint32_t rapidyenc_crc32c_2pow(int64_t n) {
+	return RapidYenc::crc32c_2pow(n);
+}
+uint32_t rapidyenc_crc32c_256pow(uint64_t n) {
+	return RapidYenc::crc32c_256pow(n);
+}
+
+int rapidyenc_crc32c_kernel() {
+	return RapidYenc::crc32c_isa_level();
+}
+
 #endif // !defined(RAPIDYENC_DISABLE_CRC)
 
@@ -28,18 +28,41 @@ RAPIDYENC_API int rapidyenc_version(void); // returns RAPIDYENC_VERSION
 #define RYKERN_AVX 0x381
 #define RYKERN_AVX2 0x403
 #define RYKERN_VBMI2 0x603
+#define RYKERN_VBMI2_512 0x607 // VBMI2 using 512-bit vectors
 // ARM specific encode/decode kernels
 #define RYKERN_NEON 0x1000
+#define RYKERN_SVE2 0x2000 // only available if built with ENABLE_EXPERIMENTAL_KERNELS
 // RISC-V specific encode/decode kernels
 #define RYKERN_RVV 0x10000
 // x86 specific CRC32 kernels
 #define RYKERN_PCLMUL 0x340
 #define RYKERN_VPCLMUL 0x440
+#define RYKERN_VPCLMUL512 0x444 // VPCLMUL using 512-bit vectors
+// x86 specific CRC32C kernels
+#define RYKERN_SSE42 0x320
 // ARM specific CRC32 kernels
 #define RYKERN_ARMCRC 8
 #define RYKERN_ARMPMULL 0x48
 // RISC-V specific CRC32 kernels
 #define RYKERN_ZBC 16
+#define RYKERN_ZVBC 32
+
+/**
+ * Callbacks for running work across multiple threads, used by the `*_parallel` functions
+ * The runner must call `task(task_data, i)` for each `i` from 0 to `num_tasks`-1, and only return once all of these calls have completed
+ * These calls may be made concurrently, e.g. by submitting them to a thread pool. `pool` is passed through, unmodified, from the `*_parallel` function
+ * If NULL is given as the runner, tasks are run serially on the calling thread
+ */
+typedef void (*RapidYencTask)(void* task_data, size_t index);
+typedef void (*RapidYencTaskRunner)(void* pool, RapidYencTask task, void* task_data, size_t num_tasks);
+
+/**
+ * A segment of non-contiguous data, used by the `*_iov` functions
+ */
+typedef struct {
+	const void* base;
+	size_t len;
+} RapidYencIovec;
 
 
 /***** ENCODE *****/
@@ -74,12 +97,99 @@ RAPIDYENC_API size_t rapidyenc_encode(const void* __restrict src, void* __restri
  */
 RAPIDYENC_API size_t rapidyenc_encode_ex(int line_size, int* column, const void* __restrict src, void* __restrict dest, size_t src_length, int is_end);
 
+/**
+ * Like `rapidyenc_encode_ex`, but writes no more than `dest_capacity` bytes to `dest`, which doesn't need to be sized with `rapidyenc_encode_max_length`
+ * As much of the input is encoded as will fit; the column is updated so that the next call can continue from where this one stopped
+ * Returns the number of bytes written to `dest`
+ *
+ * - dest_capacity: the size of `dest`. Encoding a character can take up to 4 bytes (line break + escaped character), so no progress may be made if this is less than 4
+ * - src_consumed [out]: the number of bytes of `src` which were encoded. If this is less than `src_length`, `dest` is (nearly) full, and encoding should resume from `src + *src_consumed`
+ * - is_end: only takes effect if all of `src` was consumed
+ * All other parameters are the same as `rapidyenc_encode_ex`
+ */
+RAPIDYENC_API size_t rapidyenc_encode_bounded(int line_size, int* column, const void* __restrict src, void* __restrict dest, size_t src_length, int is_end, size_t dest_capacity, size_t* src_consumed);
+
+/**
+ * Computes the exact number of bytes that `rapidyenc_encode_ex` would write for the given input, without encoding it
+ * No output buffer is needed, so this can be used to size buffers precisely before encoding (note that `rapidyenc_encode_ex` still needs the additional padding included in `rapidyenc_encode_max_length`)
+ * The input is scanned with SIMD, but lines are stepped through serially, so this generally runs at a similar speed to encoding with the fastest kernels, and faster with older ones
+ *
+ * - column [in/out]: the column to start at; this will be updated to the column `rapidyenc_encode_ex` would finish at. Pass in NULL to not track the column
+ * All other parameters are the same as `rapidyenc_encode_ex`
+ */
+RAPIDYENC_API size_t rapidyenc_encode_length(int line_size, int* column, const void* src, size_t src_length, int is_end);
+
+#ifndef RAPIDYENC_DISABLE_CRC
+/**
+ * Like `rapidyenc_encode_ex`, but also computes the CRC32 of the source data
+ * This is faster than separately calling `rapidyenc_encode_ex` and `rapidyenc_crc`, as the source data is hashed in blocks whilst it's still in cache, instead of being read from memory twice
+ * Both `rapidyenc_encode_init` and `rapidyenc_crc_init` must be called before using this function
+ *
+ * - crc [in/out]: the CRC32 to start with, which will be updated to include the data in `src`. Set this to 0 at the start of an article
+ * All other parameters are the same as `rapidyenc_encode_ex`
+ */
+RAPIDYENC_API size_t rapidyenc_encode_crc_ex(int line_size, int* column, const void* __restrict src, void* __restrict dest, size_t src_length, int is_end, uint32_t* crc);
+#endif
+
+/**
+ * Like `rapidyenc_encode_ex`, but splits the work into chunks which can be encoded on multiple threads
+ * The output is identical to that of `rapidyenc_encode_ex`. A quick scan over the input determines the column and output position at the start of each chunk, which allows each chunk to be encoded directly into its final location
+ * Chunks are at least 64KB, so smaller inputs are encoded on the calling thread
+ *
+ * - num_chunks: the maximum number of chunks to split the input into; this would typically be the number of threads available, or a small multiple of it
+ * - runner, pool: used to run the tasks, see `RapidYencTaskRunner`
+ * All other parameters are the same as `rapidyenc_encode_ex`
+ * This function needs to allocate memory for the scan (1.5 bits per input byte); if this fails, the input is encoded serially instead
+ */
+RAPIDYENC_API size_t rapidyenc_encode_parallel(int line_size, int* column, const void* __restrict src, void* __restrict dest, size_t src_length, int is_end, size_t num_chunks, RapidYencTaskRunner runner, void* pool);
+
+/**
+ * Like `rapidyenc_encode_ex`, but the source data is split across multiple segments (e.g. pages of a cache), which are encoded as if they were one contiguous buffer
+ * This avoids needing to copy the segments into a single buffer first. The SIMD kernel continues across segment boundaries, so there's little overhead to this, even for small segments
+ *
+ * - src: list of segments to encode, in order; empty segments are allowed
+ * - src_count: number of entries in `src`
+ * - dest: where to write the encoded data to; use `rapidyenc_encode_max_length` with the total length of all segments to compute the necessary size
+ * All other parameters are the same as `rapidyenc_encode_ex`
+ */
+RAPIDYENC_API size_t rapidyenc_encode_iov(int line_size, int* column, const RapidYencIovec* src, size_t src_count, void* __restrict dest, int is_end);
+
+/**
+ * Describes an article to be encoded by `rapidyenc_encode_batch`
+ */
+typedef struct {
+	const void* src; // the source data to encode
+	void* dest; // where to write the encoded data to; this must be at least `rapidyenc_encode_max_length(src_length, line_size)` bytes, and cannot overlap with any source data or other destination
+	size_t src_length; // length of `src`
+	size_t dest_length; // [out] set to the number of bytes written to `dest`
+} RapidYencEncodeJob;
+
+/**
+ * Encodes a list of complete articles in one call; each is encoded as if by `rapidyenc_encode_ex(line_size, NULL, job.src, job.dest, job.src_length, 1)`
+ * For small articles (a few KB or less), this is faster than calling `rapidyenc_encode_ex` for each, as per-call setup is only done once for the whole batch
+ * Returns the total number of bytes written across all jobs
+ *
+ * - line_size: the target number of bytes for each line
+ * - jobs: the articles to encode; `dest_length` of each will be set
+ * - num_jobs: number of entries in `jobs`
+ */
+RAPIDYENC_API size_t rapidyenc_encode_batch(int line_size, RapidYencEncodeJob* jobs, size_t num_jobs);
+
 /**
  * Returns the kernel/ISA level used for encoding
  * Values correspond with RYKERN_* definitions above
  */
 RAPIDYENC_API int rapidyenc_encode_kernel();
 
+/**
+ * Overrides the automatically selected encode kernel, which is mostly useful for benchmarking and testing
+ * `rapidyenc_encode_init` must be called before this. As it alters global state, this isn't thread-safe
+ *
+ * - kernel: one of the RYKERN_* values above; only RYKERN_GENERIC, x86 and ARM kernels can be selected
+ * Returns 1 if the kernel is now in use, or 0 if it isn't available on this CPU or build (in which case the kernel used is unspecified)
+ */
+RAPIDYENC_API int rapidyenc_encode_set_kernel(int kernel);
+
 #endif // !defined(RAPIDYENC_DISABLE_ENCODE)
 
 /**
@@ -143,6 +253,29 @@ RAPIDYENC_API size_t rapidyenc_decode(const void* src, void* dest, size_t src_le
  */
 RAPIDYENC_API size_t rapidyenc_decode_ex(int is_raw, const void* src, void* dest, size_t src_length, RapidYencDecoderState* state);
 
+/**
+ * Like `rapidyenc_decode_ex`, but splits the work into chunks which can be decoded on multiple threads
+ * The input is split after \r\n sequences, where the decoder state is known, so the output is identical to that of `rapidyenc_decode_ex`
+ * Each chunk is decoded at the same offset in `dest` as it is in `src`, then moved down to join up with the previous chunk; as such, `dest` must be at least `src_length` in size
+ * Chunks are at least 64KB, so smaller inputs are decoded on the calling thread
+ *
+ * - num_chunks: the maximum number of chunks to split the input into; this would typically be the number of threads available, or a small multiple of it
+ * - runner, pool: used to run the tasks, see `RapidYencTaskRunner`
+ * All other parameters are the same as `rapidyenc_decode_ex`
+ */
+RAPIDYENC_API size_t rapidyenc_decode_parallel(int is_raw, const void* src, void* dest, size_t src_length, RapidYencDecoderState* state, size_t num_chunks, RapidYencTaskRunner runner, void* pool);
+
+/**
+ * Like `rapidyenc_decode_ex`, but the source data is split across multiple segments (e.g. packets received from a socket), which are decoded as if they were one contiguous buffer
+ * Decoder state, including incomplete escape and dot-stuffing sequences, is carried across segment boundaries, and the SIMD kernel continues across them, so there's little overhead to this, even for small segments
+ *
+ * - src: list of segments to decode, in order; empty segments are allowed
+ * - src_count: number of entries in `src`
+ * - dest: where to write the decoded data to; this must be at least the total length of all segments in size, and must not overlap any of them
+ * All other parameters are the same as `rapidyenc_decode_ex`
+ */
+RAPIDYENC_API size_t rapidyenc_decode_iov(int is_raw, const RapidYencIovec* src, size_t src_count, void* dest, RapidYencDecoderState* state);
+
 /**
  * Like `rapidyenc_decode`, but stops decoding when a yEnc/NNTP end sequence is found
  * Returns whether such an end sequence was found
@@ -154,12 +287,175 @@ RAPIDYENC_API size_t rapidyenc_decode_ex(int is_raw, const void* src, void* dest
  */
 RAPIDYENC_API RapidYencDecoderEnd rapidyenc_decode_incremental(const void** src, void** dest, size_t src_length, RapidYencDecoderState* state);
 
+/**
+ * Like `rapidyenc_decode_incremental`, but reads from a ring buffer, decoding across the point where it wraps around without needing to copy the data out first
+ * Returns whether an end sequence was found
+ *
+ * - ring: start of the ring buffer, whose size must be a power of two
+ * - mask: size of the ring buffer minus 1
+ * - head, tail: positions of the start and end of the data to decode; these are free-running (i.e. not masked), so `tail - head` bytes are decoded, up to the size of the ring
+ * - dest: where to write the decoded data to; this must be at least `tail - head` bytes in size, and cannot be within the ring
+ * - consumed: receives the number of bytes read from the ring, i.e. the amount to advance `head` by
+ * - produced: receives the number of bytes written to `dest`
+ * If the ring buffer's address and size are multiples of `rapidyenc_decode_ring_alignment()`, the SIMD kernel continues across the wrap point on aligned loads; otherwise it's correct, but some data either side of the wrap point goes through the scalar decoder
+ */
+RAPIDYENC_API RapidYencDecoderEnd rapidyenc_decode_ring(const void* ring, size_t mask, size_t head, size_t tail, void* dest, size_t* consumed, size_t* produced, RapidYencDecoderState* state);
+
+/**
+ * Returns the alignment, in bytes, that a ring buffer given to `rapidyenc_decode_ring` should have, for decoding to stay on the SIMD kernel across the wrap point
+ * This is the block size of the selected decode kernel, e.g. 128 for RYKERN_VBMI2_512; for SVE2 and RVV, it depends on the CPU's vector length. It's 1 for RYKERN_GENERIC
+ * As it can change with `rapidyenc_decode_set_kernel`, this should be queried after the kernel is selected
+ */
+RAPIDYENC_API size_t rapidyenc_decode_ring_alignment(void);
+
+#ifndef RAPIDYENC_DISABLE_CRC
+/**
+ * Like `rapidyenc_decode_incremental`, but also computes the CRC32 of the decoded data
+ * The decoded data is hashed in blocks whilst it's still in cache, which is faster than calling `rapidyenc_crc` over the output afterwards
+ * Both `rapidyenc_decode_init` and `rapidyenc_crc_init` must be called before using this function
+ *
+ * - crc [in/out]: the CRC32 to start with, which will be updated to include the decoded data. Set this to 0 at the start of an article
+ */
+RAPIDYENC_API RapidYencDecoderEnd rapidyenc_decode_incremental_crc(const void** src, void** dest, size_t src_length, RapidYencDecoderState* state, uint32_t* crc);
+#endif
+
+/**
+ * Result of `rapidyenc_decode_article`
+ */
+typedef enum {
+	RYART_OK,
+	RYART_NO_BEGIN,   // no =ybegin line found
+	RYART_BAD_HEADER, // =ybegin line lacks size= or name=, a multi-part article's =ypart line is missing or lacks begin= or end=, or a numeric value is empty or out of range
+	RYART_TRUNCATED,  // the input, or the NNTP article (\r\n.\r\n), ended before the =yend line was complete
+	RYART_BAD_TRAILER // a control line other than =yend was found in the body, =yend lacks size=, or one of its values is empty or out of range (e.g. a CRC longer than 8 hex digits)
+} RapidYencArticleResult;
+
+#define RYART_FLAG_PART 1   // =ypart line was found
+#define RYART_FLAG_END 2    // =yend line was found
+#define RYART_FLAG_PCRC32 4 // =yend line has pcrc32=
+#define RYART_FLAG_CRC32 8  // =yend line has crc32=
+
+/**
+ * Metadata of an article parsed by `rapidyenc_decode_article`
+ * Numeric fields are 0 if not present in the article; `flags` indicates the presence of fields where 0 is a valid value
+ */
+typedef struct {
+	uint64_t size;        // =ybegin size=
+	uint64_t part_begin;  // =ypart begin=
+	uint64_t part_end;    // =ypart end=
+	uint64_t end_size;    // =yend size=
+	const char* name;     // =ybegin name=; this points into the source buffer, and isn't null terminated
+	size_t name_length;
+	size_t data_offset;   // the decoded data is at `dest + data_offset`
+	size_t data_length;   // length of the decoded data
+	size_t src_consumed;  // number of bytes of the source that were processed, up to and including the line ending of =yend
+	uint32_t pcrc32;      // =yend pcrc32=
+	uint32_t crc32;       // =yend crc32=
+	int line;             // =ybegin line=
+	int part;             // =ybegin part=
+	int total;            // =ybegin total=
+	int end_part;         // =yend part=
+	int flags;            // combination of RYART_FLAG_* values
+} RapidYencArticle;
+
+/**
+ * Parses and decodes a whole yEnc article: finds the =ybegin line (skipping anything before it), parses it and the =ypart line if present, decodes the body, then parses the =yend line
+ * `src` is the article body as received over NNTP, i.e. with dot stuffing; the NNTP terminator (\r\n.\r\n) doesn't need to be present, but if found before =yend, the article is considered truncated. The =yend line must end with a line break, otherwise it may have been cut off, so the article is also considered truncated
+ * 
+ * The decoded data is written to `dest + article->data_offset`, where the offset is the position of the yEnc body in `src`. This allows `src` and `dest` to point to the same location for in-situ decoding, without overwriting the header that `article->name` points into
+ * `dest` must be at least `src_length` in size
+ * If the result isn't RYART_OK, the fields of `article` are filled in as far as parsing got
+ */
+RAPIDYENC_API RapidYencArticleResult rapidyenc_decode_article(const void* src, size_t src_length, void* dest, RapidYencArticle* article);
+
+#ifndef RAPIDYENC_DISABLE_CRC
+/**
+ * Result of `rapidyenc_decode_article_verify`
+ */
+typedef enum {
+	RYVERIFY_OK,
+	RYVERIFY_TRUNCATED,      // the article ended before the =yend line was complete, including its line break (RYART_TRUNCATED)
+	RYVERIFY_SIZE_MISMATCH,  // the decoded length doesn't match the size given in =yend, =ypart (multi-part) or =ybegin (single-part)
+	RYVERIFY_CRC_MISMATCH,   // the CRC32 of the decoded data doesn't match pcrc32=, or crc32= for single-part articles
+	RYVERIFY_MALFORMED       // the yEnc headers couldn't be parsed (RYART_NO_BEGIN, RYART_BAD_HEADER or RYART_BAD_TRAILER)
+} RapidYencVerifyResult;
+
+/**
+ * Like `rapidyenc_decode_article`, but also computes the CRC32 of the decoded data whilst decoding, and checks it, and the decoded length, against what the article's headers specify
+ * If the article gives no CRC to check against (e.g. a multi-part article without pcrc32=), only the length is checked; this never applies to an =yend line that's been cut off, which gives RYVERIFY_TRUNCATED instead
+ * Both `rapidyenc_decode_init` and `rapidyenc_crc_init` must be called before using this function
+ *
+ * - article [out]: receives the parsed metadata, as with `rapidyenc_decode_article`; can be NULL if not needed
+ * - crc [out]: receives the CRC32 of the decoded data (e.g. for combining into a whole file's CRC32 via `rapidyenc_crc_combine`); can be NULL if not needed
+ * All other parameters are the same as `rapidyenc_decode_article`
+ */
+RAPIDYENC_API RapidYencVerifyResult rapidyenc_decode_article_verify(const void* src, size_t src_length, void* dest, RapidYencArticle* article, uint32_t* crc);
+#endif
+
+/**
+ * State for `rapidyenc_nntp_split`, which tracks responses across successive buffers
+ * Initialise with `rapidyenc_nntp_reader_init`; the fields are internal
+ */
+typedef struct {
+	int phase;
+	int status;
+	int status_length;
+	int yenc;
+	RapidYencDecoderState state;
+	int control_length;
+	char control[4];
+} RapidYencNntpReader;
+
+#define RYNNTP_YENC_BEGIN 1 // =ybegin line seen
+#define RYNNTP_YENC_END 2   // =yend line seen
+
+/**
+ * Describes the part of an NNTP response found in a buffer passed to `rapidyenc_nntp_split`
+ */
+typedef struct {
+	int status;            // NNTP status code, or -1 if the status line doesn't start with one
+	int complete;          // non-zero if the response ends in this buffer, zero if it continues into the next
+	int yenc;              // combination of RYNNTP_YENC_* flags, for the yEnc control lines seen in the response so far
+	RapidYencDecoderState state; // decoder state at the end of this part of the response
+	size_t src_offset;     // where the response starts in the buffer; 0 if continued from the previous buffer
+	size_t src_length;     // length of the response within the buffer, including the status line and the terminating .\r\n
+	size_t body_offset;    // where the body starts in the buffer (i.e. after the status line); decoded data is written to `dest + body_offset`
+	size_t decoded_length; // length of the yEnc data decoded from this part of the response
+} RapidYencNntpResponse;
+
+/**
+ * Initialises `reader` for use with `rapidyenc_nntp_split`, at the start of a response
+ */
+RAPIDYENC_API void rapidyenc_nntp_reader_init(RapidYencNntpReader* reader);
+
+/**
+ * Splits a buffer of pipelined NNTP responses (e.g. to several BODY commands), decoding the yEnc data in the body of each
+ * Each response is described by an entry in `responses`; single-line responses (e.g. "430 No Such Article") have no body. The body's yEnc control lines (=ybegin, =ypart, =yend) are skipped, and only data between =ybegin and =yend is decoded
+ * Returns the number of entries written to `responses`
+ * 
+ * Responses can span buffers: once a buffer has been processed, call this again with the next buffer and the same `reader`. The first entry will then continue the response the previous buffer ended in
+ * If `max_responses` is reached before the end of the buffer, `src_consumed` is set to where processing stopped. The rest of the buffer should be passed in again (with the same `reader`) once `responses` has been dealt with
+ *
+ * - reader: state carried between calls, set up via `rapidyenc_nntp_reader_init`
+ * - src, src_length: the buffer of received data
+ * - dest: where decoded data is written, at the same offsets as the bodies in `src`; this must be at least `src_length` in size, and may point to the same location as `src` for in-situ decoding
+ * - responses [out]: array of `max_responses` entries, which descriptions of responses will be written to
+ * - src_consumed [out]: number of bytes of `src` processed
+ */
+RAPIDYENC_API size_t rapidyenc_nntp_split(RapidYencNntpReader* reader, const void* src, size_t src_length, void* dest, RapidYencNntpResponse* responses, size_t max_responses, size_t* src_consumed);
+
 /**
  * Returns the kernel/ISA level used for decoding
  * Values correspond with RYKERN_* definitions above
  */
 RAPIDYENC_API int rapidyenc_decode_kernel();
 
+/**
+ * Overrides the automatically selected decode kernel; this works the same way as `rapidyenc_encode_set_kernel`
+ * `rapidyenc_decode_init` must be called before this
+ */
+RAPIDYENC_API int rapidyenc_decode_set_kernel(int kernel);
+
 #endif // !defined(RAPIDYENC_DISABLE_DECODE)
 
 
@@ -168,7 +464,7 @@ RAPIDYENC_API int rapidyenc_decode_kernel();
 /**
  * Initialise global state for CRC32 computation (performs CPU detection).
  * As it alters global state, this function only needs to be called once, and is not thread-safe (subsequent calls to this will do nothing).
- * This must be called before any other rapidyenc_crc* functions are called.
+ * This must be called before any other rapidyenc_crc* functions are called (including the CRC32C functions).
  */
 RAPIDYENC_API void rapidyenc_crc_init(void);
 
@@ -178,12 +474,90 @@ RAPIDYENC_API void rapidyenc_crc_init(void);
  */
 RAPIDYENC_API uint32_t rapidyenc_crc(const void* src, size_t src_length, uint32_t init_crc);
 
+/**
+ * Computes the CRC32 hashes of `count` separate buffers, where `crcs[i] = rapidyenc_crc(src[i], src_length[i], 0)`
+ * On kernels where a single stream can't saturate the CPU (e.g. ARM-CRC, or PCLMUL on large buffers), several buffers are hashed concurrently to hide instruction latency; otherwise this is equivalent to calling `rapidyenc_crc` on each buffer
+ * - src: array of `count` pointers to the data to hash
+ * - src_length: array of `count` lengths, corresponding with `src`
+ * - crcs [out]: array of `count` CRC32 values that will be written to
+ */
+RAPIDYENC_API void rapidyenc_crc_multi(const void** src, const size_t* src_length, uint32_t* crcs, size_t count);
+
+/**
+ * Like `rapidyenc_crc`, but splits the work into chunks which can be hashed on multiple threads, with the resulting CRCs then combined
+ * This is useful for large inputs, such as a memory-mapped file. Chunks are at least 64KB, so smaller inputs are hashed on the calling thread
+ *
+ * - num_chunks: the maximum number of chunks to split the input into; this would typically be the number of threads available
+ * - runner, pool: used to run the tasks, see `RapidYencTaskRunner`
+ * All other parameters are the same as `rapidyenc_crc`
+ */
+RAPIDYENC_API uint32_t rapidyenc_crc_parallel(const void* src, size_t src_length, uint32_t init_crc, size_t num_chunks, RapidYencTaskRunner runner, void* pool);
+
+/**
+ * Splits `src` into consecutive blocks of `block_size` bytes, and computes the CRC32 of each block, as well as the CRC32 of the whole of `src`
+ * This is useful for generating PAR2 slice checksums. The blocks are hashed concurrently where the kernel benefits from it (see `rapidyenc_crc_multi`), and the CRC of the whole buffer is derived from the block CRCs instead of hashing the data again
+ * - block_size: the size of each block; if `src_length` isn't a multiple of this, the final block will be shorter. For PAR2, where the last slice is zero padded, use `rapidyenc_crc_zeros` to extend its CRC
+ * - block_crcs [out]: array that the CRC32 of each block will be written to; must be able to hold `ceil(src_length / block_size)` entries
+ * Returns the CRC32 of all of `src`, or 0 if `src_length` or `block_size` is 0
+ */
+RAPIDYENC_API uint32_t rapidyenc_crc_blocks(const void* src, size_t src_length, size_t block_size, uint32_t* block_crcs);
+
+/**
+ * State for computing the CRC32 of a window of fixed size, sliding over data one byte at a time
+ * Set up via `rapidyenc_crc_rolling_init`; the state is only read from afterwards, so it can be shared across threads
+ */
+typedef struct {
+	uint32_t in_table[256];
+	uint32_t out_table[256];
+	size_t window_size;
+} RapidYencCrcRolling;
+
+/**
+ * Initialises `state` for a rolling CRC32 over windows of `window_size` bytes
+ */
+RAPIDYENC_API void rapidyenc_crc_rolling_init(RapidYencCrcRolling* state, size_t window_size);
+
+/**
+ * Given `crc = rapidyenc_crc(data + i, window_size, 0)`, returns `rapidyenc_crc(data + i+1, window_size, 0)` in constant time
+ * - byte_out: the byte leaving the window, i.e. `data[i]`
+ * - byte_in: the byte entering the window, i.e. `data[i + window_size]`
+ * The CRC of the first window needs to be computed via `rapidyenc_crc`
+ */
+RAPIDYENC_API uint32_t rapidyenc_crc_roll(const RapidYencCrcRolling* state, uint32_t crc, uint8_t byte_out, uint8_t byte_in);
+
+/**
+ * A window found by `rapidyenc_crc_rolling_search`
+ */
+typedef struct {
+	size_t offset; // where the window starts, relative to `src`
+	size_t target; // index into `targets` of the CRC it matched
+} RapidYencCrcMatch;
+
+/**
+ * Finds all windows in `src` whose CRC32 matches one of `targets`, such as locating PAR2 slices in a damaged or misaligned file
+ * Every window lying entirely within `src` is checked, i.e. offsets 0 to `src_length - window_size`; to search data that arrives in pieces, overlap consecutive calls by `window_size - 1` bytes
+ * Returns the number of matches written to `matches`, in ascending order of offset. If this equals `max_matches`, there may be more; the search can be resumed from one byte after the last match
+ * If several targets have the same CRC, the lowest index is reported
+ *
+ * - state: set up via `rapidyenc_crc_rolling_init`
+ * - targets: array of `num_targets` CRC32 values to look for
+ * - matches [out]: array of `max_matches` entries, which matches will be written to
+ */
+RAPIDYENC_API size_t rapidyenc_crc_rolling_search(const RapidYencCrcRolling* state, const void* src, size_t src_length, const uint32_t* targets, size_t num_targets, RapidYencCrcMatch* matches, size_t max_matches);
+
 /**
  * Given `crc1 = CRC32(data1)` and `crc2 = CRC32(data2)`, returns CRC32(data1 + data2)
  * `length2` refers to the length of 'data2'
  */
 RAPIDYENC_API uint32_t rapidyenc_crc_combine(uint32_t crc1, const uint32_t crc2, uint64_t length2);
 
+/**
+ * Performs `out[i] = rapidyenc_crc_combine(crc1[i], crc2[i], length2[i])` for each of `count` entries
+ * This is considerably faster than calling `rapidyenc_crc_combine` in a loop, as the work for each entry can overlap with the others
+ * `out` may point to the same location as `crc1` or `crc2`
+ */
+RAPIDYENC_API void rapidyenc_crc_combine_many(const uint32_t* crc1, const uint32_t* crc2, const uint64_t* length2, uint32_t* out, size_t count);
+
 /**
  * Returns `rapidyenc_crc(src, length, init_crc)` where 'src' is all zeroes
  */
@@ -211,12 +585,70 @@ RAPIDYENC_API uint32_t rapidyenc_crc_2pow(int64_t n);
  */
 RAPIDYENC_API uint32_t rapidyenc_crc_256pow(uint64_t n);
 
+/**
+ * Performs `out[i] = rapidyenc_crc_256pow(n[i])` for each of `count` entries
+ * This is considerably faster than calling `rapidyenc_crc_256pow` in a loop
+ * `out` may overlap with `n`, as long as it starts at the same location
+ */
+RAPIDYENC_API void rapidyenc_crc_256pow_many(const uint64_t* n, uint32_t* out, size_t count);
+
 /**
  * Returns the kernel/ISA level used for CRC32 computation
  * Values correspond with RYKERN_* definitions above
  */
 RAPIDYENC_API int rapidyenc_crc_kernel();
 
+
+/***** CRC32C *****/
+/* The following functions mirror the CRC32 functions above, but use the Castagnoli polynomial (as used by iSCSI, ext4, etc)
+ * `rapidyenc_crc_init` must be called before using these functions
+ */
+
+/**
+ * Returns the CRC32C hash of `src` (of length `src_length`), with initial CRC32C value `init_crc`
+ * The initial value should be 0 unless this is a subsequent call during incremental hashing
+ */
+RAPIDYENC_API uint32_t rapidyenc_crc32c(const void* src, size_t src_length, uint32_t init_crc);
+
+/**
+ * Given `crc1 = CRC32C(data1)` and `crc2 = CRC32C(data2)`, returns CRC32C(data1 + data2)
+ * `length2` refers to the length of 'data2'
+ */
+RAPIDYENC_API uint32_t rapidyenc_crc32c_combine(uint32_t crc1, const uint32_t crc2, uint64_t length2);
+
+/**
+ * Returns `rapidyenc_crc32c(src, length, init_crc)` where 'src' is all zeroes
+ */
+RAPIDYENC_API uint32_t rapidyenc_crc32c_zeros(uint32_t init_crc, uint64_t length);
+
+/**
+ * Performs the inverse of `rapidyenc_crc32c_zeros`:
+ * Given `init_crc = CRC32C(data + [0]*length)`, returns `CRC32C(data)`
+ */
+RAPIDYENC_API uint32_t rapidyenc_crc32c_unzero(uint32_t init_crc, uint64_t length);
+
+/**
+ * Returns the product of `a` and `b` in the CRC32C field
+ */
+RAPIDYENC_API uint32_t rapidyenc_crc32c_multiply(uint32_t a, uint32_t b);
+
+/**
+ * Returns 2**n in the CRC32C field. n can be negative
+ */
+RAPIDYENC_API uint32_t rapidyenc_crc32c_2pow(int64_t n);
+
+/**
+ * Returns 2**(8n) in the CRC32C field
+ * Similar to `rapidyenc_crc32c_2pow(8*n)`, but avoids overflow and n cannot be negative
+ */
+RAPIDYENC_API uint32_t rapidyenc_crc32c_256pow(uint64_t n);
+
+/**
+ * Returns the kernel/ISA level used for CRC32C computation
+ * Values correspond with RYKERN_* definitions above
+ */
+RAPIDYENC_API int rapidyenc_crc32c_kernel();
+
 #endif // !defined(RAPIDYENC_DISABLE_CRC)
 
 #ifdef __cplusplus
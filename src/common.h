@@ -213,9 +213,38 @@ static HEDLEY_ALWAYS_INLINE uint8x16x4_t vcreate4_u8(uint8x16_t a, uint8x16_t b,
 }
 # undef _CREATE_TUPLE
 #endif
+
+#if defined(__ARM_FEATURE_SVE2) && defined(__has_include)
+# if !__has_include(<arm_sve.h>)
+#  undef __ARM_FEATURE_SVE2
+HEDLEY_WARNING("SVE2 has been disabled due to missing arm_sve.h");
+# endif
+#endif
+
+#ifdef __ARM_FEATURE_SVE2
+# include <arm_sve.h>
+
+// SVE only has COMPACT for 32/64-bit elements, so bytes are widened to 32-bit, compacted, then narrowed back by a truncating store
+// only the selected bytes are written, so nothing past the end of the output is touched
+static HEDLEY_ALWAYS_INLINE uint8_t* svcompact_store_u8_u16(uint8_t* p, svbool_t keep, svuint16_t data) {
+	svbool_t keepLo = svunpklo_b(keep);
+	svbool_t keepHi = svunpkhi_b(keep);
+	uint64_t countLo = svcntp_b32(svptrue_b32(), keepLo);
+	uint64_t countHi = svcntp_b32(svptrue_b32(), keepHi);
+	svst1b_u32(svwhilelt_b32((uint64_t)0, countLo), p, svcompact_u32(keepLo, svunpklo_u32(data)));
+	svst1b_u32(svwhilelt_b32((uint64_t)0, countHi), p + countLo, svcompact_u32(keepHi, svunpkhi_u32(data)));
+	return p + countLo + countHi;
+}
+static HEDLEY_ALWAYS_INLINE uint8_t* svcompact_store_u8(uint8_t* p, svbool_t keep, svuint8_t data) {
+	p = svcompact_store_u8_u16(p, svunpklo_b(keep), svunpklo_u16(data));
+	return svcompact_store_u8_u16(p, svunpkhi_b(keep), svunpkhi_u16(data));
+}
+#endif
 #ifdef PLATFORM_ARM
 namespace RapidYenc {
 	bool cpu_supports_neon();
+	bool cpu_supports_sve2();
+	size_t cpu_sve_length(); // in bytes, or 0 if unknown
 }
 #endif
 
@@ -232,10 +261,13 @@ enum YEncDecIsaLevel {
 	ISA_FEATURE_POPCNT = 0x1,
 	ISA_FEATURE_LZCNT = 0x2,
 	ISA_FEATURE_EVEX512 = 0x4, // AVX512 support
+	ISA_FEATURE_FAST512 = 0x8, // 512-bit vectors can be used without the CPU significantly lowering its clock speed
+	ISA_FEATURE_FULL512 = 0x10, // 512-bit shuffles have the same throughput as 256-bit ones
 	ISA_LEVEL_SSE2 = 0x100,
 	ISA_LEVEL_SSSE3 = 0x200,
 	ISA_LEVEL_SSE41 = 0x300,
 	ISA_LEVEL_SSE4_POPCNT = 0x301,
+	ISA_LEVEL_SSE42 = 0x320, // SSE4.2 + PCLMUL; only used for CRC32C
 	ISA_LEVEL_PCLMUL = 0x340,
 	ISA_LEVEL_AVX = 0x381, // same as above, just used as a differentiator for `cpu_supports_isa`
 	ISA_LEVEL_AVX2 = 0x403, // also includes BMI1/2 and LZCNT
@@ -248,12 +280,14 @@ enum YEncDecIsaLevel {
 	ISA_GENERIC = 0,
 	ISA_FEATURE_CRC = 8,
 	ISA_FEATURE_PMULL = 0x40,
-	ISA_LEVEL_NEON = 0x1000
+	ISA_LEVEL_NEON = 0x1000,
+	ISA_LEVEL_SVE2 = 0x2000
 };
 #elif defined(__riscv)
 enum YEncDecIsaLevel {
 	ISA_GENERIC = 0,
 	ISA_FEATURE_ZBC = 16,
+	ISA_FEATURE_ZVBC = 32,
 	ISA_LEVEL_RVV = 0x10000
 };
 #else
@@ -293,6 +327,7 @@ enum YEncDecIsaLevel {
 namespace RapidYenc {
 	int cpu_supports_isa();
 	int cpu_supports_crc_isa();
+	bool cpu_supports_crc32c();
 }
 #endif // PLATFORM_X86
 
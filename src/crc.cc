@@ -5,8 +5,11 @@
 
 #include "interface.h"
 crcutil_interface::CRC* crc = NULL;
-#define GENERIC_CRC_INIT crc = crcutil_interface::CRC::Create(0xEDB88320, 0, 32, true, 0, 0, 0, 0, NULL)
-// instance never deleted... oh well...
+crcutil_interface::CRC* crc_c = NULL;
+#define GENERIC_CRC_INIT \
+	crc = crcutil_interface::CRC::Create(0xEDB88320, 0, 32, true, 0, 0, 0, 0, NULL); \
+	crc_c = crcutil_interface::CRC::Create(0x82F63B78, 0, 32, true, 0, 0, 0, 0, NULL)
+// instances never deleted... oh well...
 
 static uint32_t do_crc32_incremental_generic(const void* data, size_t length, uint32_t init) {
 	// use optimised ASM on x86 platforms
@@ -14,11 +17,17 @@ static uint32_t do_crc32_incremental_generic(const void* data, size_t length, ui
 	crc->Compute(data, length, &tmp);
 	return (uint32_t)tmp;
 }
+static uint32_t do_crc32c_incremental_generic(const void* data, size_t length, uint32_t init) {
+	crcutil_interface::UINT64 tmp = init;
+	crc_c->Compute(data, length, &tmp);
+	return (uint32_t)tmp;
+}
 
 #else
 // don't use crcutil
 
 static uint32_t* HEDLEY_RESTRICT crc_slice_table;
+static uint32_t* HEDLEY_RESTRICT crc32c_slice_table;
 #if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
 # if defined(__GNUC__) || defined(__clang__)
 #  define bswap32 __builtin_bswap32
@@ -30,7 +39,7 @@ static inline uint32_t bswap32(uint32_t x) {
 #endif
 
 #define CRC32_GENERIC_CHAINS 4 // newer processors may prefer 8
-static uint32_t do_crc32_incremental_generic(const void* data, size_t length, uint32_t init) {
+static HEDLEY_ALWAYS_INLINE uint32_t crc_calc_generic(const uint32_t* HEDLEY_RESTRICT crc_slice_table, const void* data, size_t length, uint32_t init) {
 	const uint32_t* crc_base_table = crc_slice_table + 4*256; // this also seems to help MSVC's optimiser, which otherwise keeps trying to add to crc_slice_table every time it's referenced
 	uint32_t crc[CRC32_GENERIC_CHAINS]; // Clang seems to be more spill happy with an array over individual variables :(
 	crc[0] = ~init;
@@ -98,14 +107,20 @@ static uint32_t do_crc32_incremental_generic(const void* data, size_t length, ui
 	}
 	return ~crc[0];
 }
-static void generate_crc32_slice_table() {
-	crc_slice_table = (uint32_t*)malloc(5*256*sizeof(uint32_t));
+static uint32_t do_crc32_incremental_generic(const void* data, size_t length, uint32_t init) {
+	return crc_calc_generic(crc_slice_table, data, length, init);
+}
+static uint32_t do_crc32c_incremental_generic(const void* data, size_t length, uint32_t init) {
+	return crc_calc_generic(crc32c_slice_table, data, length, init);
+}
+static uint32_t* generate_crc_slice_table(uint32_t poly) {
+	uint32_t* crc_slice_table = (uint32_t*)malloc(5*256*sizeof(uint32_t));
 	// generate standard byte-by-byte table
 	uint32_t* crc_base_table = crc_slice_table + 4*256;
 	for(int v=0; v<256; v++) {
 		uint32_t crc = v;
 		for(int j = 0; j < 8; j++) {
-			crc = (crc >> 1) ^ (-(int32_t)(crc & 1) & 0xEDB88320);
+			crc = (crc >> 1) ^ (-(int32_t)(crc & 1) & poly);
 		}
 		crc_base_table[v] = crc;
 	}
@@ -127,9 +142,12 @@ static void generate_crc32_slice_table() {
 		}
 		#endif
 	}
+	return crc_slice_table;
 }
 
-#define GENERIC_CRC_INIT generate_crc32_slice_table()
+#define GENERIC_CRC_INIT \
+	crc_slice_table = generate_crc_slice_table(0xEDB88320); \
+	crc32c_slice_table = generate_crc_slice_table(0x82F63B78)
 #endif
 
 
@@ -137,17 +155,23 @@ namespace RapidYenc {
 
 // workaround MSVC complaining "unary minus operator applied to unsigned type, result still unsigned"
 #define NEGATE(n) (uint32_t)(-((int32_t)(n)))
-uint32_t crc32_multiply_generic(uint32_t a, uint32_t b) {
+static HEDLEY_ALWAYS_INLINE uint32_t crc_multiply_generic(uint32_t a, uint32_t b, uint32_t poly) {
 	uint32_t res = 0;
 	for(int i=0; i<31; i++) {
 		res ^= NEGATE(b>>31) & a;
-		a = ((a >> 1) ^ (0xEDB88320 & NEGATE(a&1)));
+		a = ((a >> 1) ^ (poly & NEGATE(a&1)));
 		b <<= 1;
 	}
 	res ^= NEGATE(b>>31) & a;
 	return res;
 }
 #undef NEGATE
+uint32_t crc32_multiply_generic(uint32_t a, uint32_t b) {
+	return crc_multiply_generic(a, b, 0xEDB88320);
+}
+uint32_t crc32c_multiply_generic(uint32_t a, uint32_t b) {
+	return crc_multiply_generic(a, b, 0x82F63B78);
+}
 
 const uint32_t crc_power[32] = { // pre-computed 2^(2^n)
 	0x40000000, 0x20000000, 0x08000000, 0x00800000, 0x00008000, 0xedb88320, 0xb1e6b092, 0xa06a2517,
@@ -155,25 +179,31 @@ const uint32_t crc_power[32] = { // pre-computed 2^(2^n)
 	0x83852d0f, 0x30362f1a, 0x7b5a9cc3, 0x31fec169, 0x9fec022a, 0x6c8dedc4, 0x15d6874d, 0x5fde7a4e,
 	0xbad90e37, 0x2e4e5eef, 0x4eaba214, 0xa8a472c0, 0x429a969e, 0x148d302a, 0xc40ba6d0, 0xc4e22c3c
 };
+const uint32_t crc32c_power[32] = { // as above, for CRC32C; 2^(2^31) wraps around to 2^1
+	0x40000000, 0x20000000, 0x08000000, 0x00800000, 0x00008000, 0x82f63b78, 0x6ea2d55c, 0x18b8ea18,
+	0x510ac59a, 0xb82be955, 0xb8fdb1e7, 0x88e56f72, 0x74c360a4, 0xe4172b16, 0x0d65762a, 0x35d73a62,
+	0x28461564, 0xbf455269, 0xe2ea32dc, 0xfe7740e6, 0xf946610b, 0x3c204f8f, 0x538586e3, 0x59726915,
+	0x734d5309, 0xbc1ac763, 0x7d0722cc, 0xd289cabe, 0xe94ca9bc, 0x05b74f3f, 0xa51e1f42, 0x40000000
+};
 
-uint32_t crc32_shift_generic(uint32_t crc1, uint32_t n) {
+static HEDLEY_ALWAYS_INLINE uint32_t crc_shift_generic(uint32_t crc1, uint32_t n, const uint32_t* power_table, uint32_t poly) {
 	uint32_t result = crc1;
 #ifdef __GNUC__
 	while(n) {
-		result = crc32_multiply_generic(result, crc_power[__builtin_ctz(n)]);
+		result = crc_multiply_generic(result, power_table[__builtin_ctz(n)], poly);
 		n &= n-1;
 	}
 #elif defined(_MSC_VER)
 	unsigned long power;
 	while(_BitScanForward(&power, n)) {
-		result = crc32_multiply_generic(result, crc_power[power]);
+		result = crc_multiply_generic(result, power_table[power], poly);
 		n &= n-1;
 	}
 #else
 	unsigned power = 0;
 	while(n) {
 		if(n & 1) {
-			result = crc32_multiply_generic(result, crc_power[power]);
+			result = crc_multiply_generic(result, power_table[power], poly);
 		}
 		n >>= 1;
 		power++;
@@ -181,12 +211,112 @@ uint32_t crc32_shift_generic(uint32_t crc1, uint32_t n) {
 #endif
 	return result;
 }
+uint32_t crc32_shift_generic(uint32_t crc1, uint32_t n) {
+	return crc_shift_generic(crc1, n, crc_power, 0xEDB88320);
+}
+uint32_t crc32c_shift_generic(uint32_t crc1, uint32_t n) {
+	return crc_shift_generic(crc1, n, crc32c_power, 0x82F63B78);
+}
+
+uint32_t crc_power_byte[4][256];
+static void generate_crc_power_byte() {
+	for(int k=0; k<4; k++) {
+		crc_power_byte[k][0] = 0x80000000;
+		for(int b=1; b<256; b++)
+			crc_power_byte[k][b] = crc32_multiply_generic(crc_power_byte[k][b & (b-1)], crc_power[k*8 + ctz32(b)]);
+	}
+}
+
+struct crc_mul_generic {
+	static HEDLEY_ALWAYS_INLINE uint32_t mul(uint32_t a, uint32_t b) {
+		return crc_multiply_generic(a, b, 0xEDB88320);
+	}
+};
+void crc32_shift_many_generic(uint32_t* crc, const uint32_t* n, size_t count) {
+	crc32_shift_many_table<crc_mul_generic>(crc, n, count);
+}
+} // namespace
+
+
+namespace RapidYenc {
+void crc32_multi_generic(const void* const* data, const size_t* length, uint32_t* crc, size_t count) {
+	for(size_t i=0; i<count; i++)
+		crc[i] = crc32(data[i], length[i], 0);
+}
+
+uint32_t crc32_blocks(const void* src, size_t len, size_t blockSize, uint32_t* crcs) {
+	if(!blockSize || !len) return 0;
+	const unsigned char* data = (const unsigned char*)src;
+	size_t numBlocks = (len + blockSize-1) / blockSize;
+	
+	// hash the blocks in batches via the multi-buffer kernel, so that the CPU isn't left idle waiting on each block's final reduction before starting the next
+	const size_t BATCH = 32;
+	const void* batchSrc[BATCH];
+	size_t batchLen[BATCH];
+	for(size_t block=0; block<numBlocks; block+=BATCH) {
+		size_t count = numBlocks - block;
+		if(count > BATCH) count = BATCH;
+		for(size_t i=0; i<count; i++) {
+			size_t offset = (block+i) * blockSize;
+			batchSrc[i] = data + offset;
+			batchLen[i] = (len - offset < blockSize) ? len - offset : blockSize;
+		}
+		crc32_multi(batchSrc, batchLen, crcs + block, count);
+	}
+	
+	// join the blocks' CRCs together; all blocks but the last are the same length, so the shift amount only needs to be computed once
+	uint32_t blockPow = crc32_bytepow(blockSize);
+	uint32_t crc = 0;
+	for(size_t i=0; i<numBlocks-1; i++)
+		crc = crc32_shift(crc, blockPow) ^ crcs[i];
+	return crc32_combine(crc, crcs[numBlocks-1], len - (numBlocks-1)*blockSize);
+}
+
+// the shifts are done in batches, as the exponents need to be computed first
+#define SHIFT_MANY_BATCH 256
+void crc32_combine_many(const uint32_t* crc1, const uint32_t* crc2, const uint64_t* len2, uint32_t* out, size_t count) {
+	uint32_t crc[SHIFT_MANY_BATCH];
+	uint32_t pow[SHIFT_MANY_BATCH];
+	for(size_t i=0; i<count; i+=SHIFT_MANY_BATCH) {
+		size_t batch = count - i;
+		if(batch > SHIFT_MANY_BATCH) batch = SHIFT_MANY_BATCH;
+		for(size_t j=0; j<batch; j++) {
+			crc[j] = crc1[i+j];
+			pow[j] = crc32_bytepow(len2[i+j]);
+		}
+		crc32_shift_many(crc, pow, batch);
+		// `out` may alias the inputs, so only write to it after everything has been read
+		for(size_t j=0; j<batch; j++)
+			out[i+j] = crc[j] ^ crc2[i+j];
+	}
+}
+void crc32_256pow_many(const uint64_t* n, uint32_t* out, size_t count) {
+	uint32_t pow[SHIFT_MANY_BATCH];
+	for(size_t i=0; i<count; i+=SHIFT_MANY_BATCH) {
+		size_t batch = count - i;
+		if(batch > SHIFT_MANY_BATCH) batch = SHIFT_MANY_BATCH;
+		for(size_t j=0; j<batch; j++)
+			pow[j] = crc32_bytepow(n[i+j]);
+		// the exponents are computed beforehand, as `out` may alias `n`
+		for(size_t j=0; j<batch; j++)
+			out[i+j] = 0x80000000;
+		crc32_shift_many(out + i, pow, batch);
+	}
+}
+#undef SHIFT_MANY_BATCH
 } // namespace
 
 
 namespace RapidYenc {
 	crc_func _do_crc32_incremental = &do_crc32_incremental_generic;
+	crc_multi_func _do_crc32_multi = &crc32_multi_generic;
+	
+	crc_func _do_crc32c_incremental = &do_crc32c_incremental_generic;
+	crc_mul_func _crc32c_shift = &crc32c_shift_generic;
+	crc_mul_func _crc32c_multiply = &crc32c_multiply_generic;
+	int _crc32c_isa = ISA_GENERIC;
 	crc_mul_func _crc32_shift = &crc32_shift_generic;
+	crc_shift_many_func _crc32_shift_many = &crc32_shift_many_generic;
 	crc_mul_func _crc32_multiply = &crc32_multiply_generic;
 	int _crc32_isa = ISA_GENERIC;
 }
@@ -230,13 +360,18 @@ static unsigned long getauxval(unsigned long cap) {
 
 void RapidYenc::crc32_init() {
 	GENERIC_CRC_INIT;
+	generate_crc_power_byte();
 	
 #ifdef PLATFORM_X86
 	int support = cpu_supports_crc_isa();
-	if(support == 2)
+	if(support == 3)
+		crc_clmul512_set_funcs();
+	else if(support == 2)
 		crc_clmul256_set_funcs();
 	else if(support == 1)
 		crc_clmul_set_funcs();
+	if(cpu_supports_crc32c())
+		crc32c_sse42_set_funcs();
 #endif
 #ifdef PLATFORM_ARM
 # ifdef __APPLE__
@@ -292,6 +427,13 @@ void RapidYenc::crc32_init() {
 		if(p.value & (rv_hwprobe_ext_zbc | rv_hwprobe_ext_zbkc)) {
 			crc_riscv_set_funcs();
 		}
+#  ifdef YENC_ENABLE_EXPERIMENTAL_KERNELS
+		// the vector kernel falls back to whichever of the above was selected for short lengths
+		const int rv_hwprobe_ima_v = 1 << 2, rv_hwprobe_ext_zvbc = 1 << 18;
+		if((p.value & (rv_hwprobe_ima_v | rv_hwprobe_ext_zvbc)) == (rv_hwprobe_ima_v | rv_hwprobe_ext_zvbc)) {
+			crc_riscv_zvbc_set_funcs();
+		}
+#  endif
 	}
 # endif
 #endif
@@ -1,6 +1,7 @@
 #ifndef __YENC_CRC_H
 #define __YENC_CRC_H
 #include <stdlib.h> // for llabs
+#include "parallel.h"
 
 #if !defined(__GNUC__) && defined(_MSC_VER)
 # include <intrin.h>
@@ -16,6 +17,11 @@ extern int _crc32_isa;
 static inline uint32_t crc32(const void* data, size_t length, uint32_t init) {
 	return (*_do_crc32_incremental)(data, length, init);
 }
+typedef void (*crc_multi_func)(const void* const*, const size_t*, uint32_t*, size_t);
+extern crc_multi_func _do_crc32_multi;
+static inline void crc32_multi(const void* const* data, const size_t* length, uint32_t* crc, size_t count) {
+	(*_do_crc32_multi)(data, length, crc, count);
+}
 static inline int crc32_isa_level() {
 	return _crc32_isa;
 }
@@ -66,6 +72,13 @@ static inline uint32_t crc32_multiply(uint32_t a, uint32_t b) {
 	return (*_crc32_multiply)(a, b);
 }
 
+// computes `crc[i] = crc32_shift(crc[i], n[i])` for each of `count` values
+typedef void (*crc_shift_many_func)(uint32_t*, const uint32_t*, size_t);
+extern crc_shift_many_func _crc32_shift_many;
+static inline void crc32_shift_many(uint32_t* crc, const uint32_t* n, size_t count) {
+	(*_crc32_shift_many)(crc, n, count);
+}
+
 static inline uint32_t crc32_combine(uint32_t crc1, uint32_t crc2, uint64_t len2) {
 	return crc32_shift(crc1, crc32_bytepow(len2)) ^ crc2;
 }
@@ -83,7 +96,80 @@ static inline uint32_t crc32_256pow(uint64_t n) {
 	return crc32_shift(0x80000000, crc32_bytepow(n));
 }
 
+
+// CRC32C (Castagnoli polynomial)
+// unlike CRC32, the multiplicative order of 2 in this field is 2^31-1, so exponents are reduced modulo that instead
+extern crc_func _do_crc32c_incremental;
+extern int _crc32c_isa;
+static inline uint32_t crc32c(const void* data, size_t length, uint32_t init) {
+	return (*_do_crc32c_incremental)(data, length, init);
+}
+static inline int crc32c_isa_level() {
+	return _crc32c_isa;
+}
+
+// computes `n % 0x7fffffff`
+static inline uint32_t crc32c_powmod(uint64_t n) {
+	n = (n >> 31) + (n & 0x7fffffff);
+	n = (n >> 31) + (n & 0x7fffffff);
+	if(n >= 0x7fffffff) n -= 0x7fffffff;
+	return (uint32_t)n;
+}
+// computes `crc32c_powmod(n*8)` avoiding overflow
+static inline uint32_t crc32c_bytepow(uint64_t n) {
+	return crc32c_powmod((uint64_t)crc32c_powmod(n) << 3);
+}
+
+extern crc_mul_func _crc32c_shift;
+extern crc_mul_func _crc32c_multiply;
+static inline uint32_t crc32c_shift(uint32_t a, uint32_t b) {
+	return (*_crc32c_shift)(a, b);
+}
+static inline uint32_t crc32c_multiply(uint32_t a, uint32_t b) {
+	return (*_crc32c_multiply)(a, b);
+}
+
+static inline uint32_t crc32c_combine(uint32_t crc1, uint32_t crc2, uint64_t len2) {
+	return crc32c_shift(crc1, crc32c_bytepow(len2)) ^ crc2;
+}
+static inline uint32_t crc32c_zeros(uint32_t crc1, uint64_t len) {
+	return ~crc32c_shift(~crc1, crc32c_bytepow(len));
+}
+static inline uint32_t crc32c_unzero(uint32_t crc1, uint64_t len) {
+	return ~crc32c_shift(~crc1, 0x7fffffff - crc32c_bytepow(len));
+}
+static inline uint32_t crc32c_2pow(int64_t n) {
+	uint32_t e = crc32c_powmod(llabs(n));
+	return crc32c_shift(0x80000000, n < 0 ? 0x7fffffff - e : e);
+}
+static inline uint32_t crc32c_256pow(uint64_t n) {
+	return crc32c_shift(0x80000000, crc32c_bytepow(n));
+}
+
+
 void crc32_init();
+uint32_t crc32_parallel(const void* src, size_t len, uint32_t init, size_t numChunks, task_runner runner, void* pool);
+uint32_t crc32_blocks(const void* src, size_t len, size_t blockSize, uint32_t* crcs);
+void crc32_combine_many(const uint32_t* crc1, const uint32_t* crc2, const uint64_t* len2, uint32_t* out, size_t count);
+void crc32_256pow_many(const uint64_t* n, uint32_t* out, size_t count);
+
+// rolling CRC32 over a fixed size window; layout must match RapidYencCrcRolling
+struct crc_rolling {
+	uint32_t in[256];
+	uint32_t out[256];
+	size_t window;
+};
+// layout must match RapidYencCrcMatch
+struct crc_rolling_match {
+	size_t offset;
+	size_t target;
+};
+void crc32_rolling_init(crc_rolling* roll, size_t window);
+// given `crc` of the window starting at some offset, returns the CRC of the window starting one byte later; `byteOut` is the first byte of the old window, `byteIn` is the last byte of the new one
+static inline uint32_t crc32_roll(const crc_rolling* roll, uint32_t crc, uint8_t byteOut, uint8_t byteIn) {
+	return (crc >> 8) ^ roll->in[(crc ^ byteIn) & 0xff] ^ roll->out[byteOut];
+}
+size_t crc32_rolling_search(const crc_rolling* roll, const void* src, size_t len, const uint32_t* targets, size_t numTargets, crc_rolling_match* matches, size_t maxMatches);
 
 
 
@@ -75,6 +75,15 @@ static uint32_t crc32_multiply_arm(uint32_t a, uint32_t b) {
 	res = __crc32w(0, res) ^ (res >> 32);
 	return res;
 }
+
+struct crc_mul_arm {
+	static HEDLEY_ALWAYS_INLINE uint32_t mul(uint32_t a, uint32_t b) {
+		return crc32_multiply_arm(a, b);
+	}
+};
+static void crc32_shift_many_arm(uint32_t* crc, const uint32_t* n, size_t count) {
+	RapidYenc::crc32_shift_many_table<crc_mul_arm>(crc, n, count);
+}
 #endif
 // regular multiply is probably better for AArch32
 
@@ -193,6 +202,49 @@ static uint32_t do_crc32_incremental_arm(const void* data, size_t length, uint32
 	return ~arm_crc_calc(~init, (const unsigned char*)data, (long)length);
 }
 
+#ifdef YENC_ENABLE_EXPERIMENTAL_KERNELS
+// multi-buffer CRC: a single stream is limited by the latency of the CRC instruction, so interleave several buffers to keep it busy
+static HEDLEY_ALWAYS_INLINE WORD_T read_word(const unsigned char* src) {
+	WORD_T data;
+	memcpy(&data, src, sizeof(data)); // buffers may not be aligned
+	return data;
+}
+struct crc_multi_arm {
+	typedef uint32_t state;
+	static const unsigned LANES = 4;
+	static const size_t BLOCK = sizeof(WORD_T)*4;
+	static const size_t MIN_LENGTH = BLOCK;
+	
+	static HEDLEY_ALWAYS_INLINE void start(uint32_t& crc, const unsigned char* src) {
+		crc = 0xffffffff;
+		for(unsigned i=0; i<BLOCK; i+=sizeof(WORD_T))
+			crc = CRC_WORD(crc, read_word(src + i));
+	}
+	static HEDLEY_ALWAYS_INLINE void run(uint32_t* state, const unsigned char** src, size_t steps) {
+		// copy lanes to locals, so that they can be kept in registers
+		uint32_t crc0 = state[0], crc1 = state[1], crc2 = state[2], crc3 = state[3];
+		const unsigned char *src0 = src[0], *src1 = src[1], *src2 = src[2], *src3 = src[3];
+		for(size_t i=0; i<steps*BLOCK; i+=sizeof(WORD_T)) {
+			crc0 = CRC_WORD(crc0, read_word(src0 + i));
+			crc1 = CRC_WORD(crc1, read_word(src1 + i));
+			crc2 = CRC_WORD(crc2, read_word(src2 + i));
+			crc3 = CRC_WORD(crc3, read_word(src3 + i));
+		}
+		state[0] = crc0; state[1] = crc1; state[2] = crc2; state[3] = crc3;
+		src[0] = src0 + steps*BLOCK;
+		src[1] = src1 + steps*BLOCK;
+		src[2] = src2 + steps*BLOCK;
+		src[3] = src3 + steps*BLOCK;
+	}
+	static HEDLEY_ALWAYS_INLINE uint32_t finish(uint32_t crc, const unsigned char* src, size_t len) {
+		return ~arm_crc_calc(crc, src, (long)len);
+	}
+};
+static void do_crc32_multi_arm(const void* const* data, const size_t* length, uint32_t* crc, size_t count) {
+	RapidYenc::crc32_multi_lockstep<crc_multi_arm>(data, length, crc, count);
+}
+#endif
+
 
 #if defined(__aarch64__) && (defined(__GNUC__) || defined(_MSC_VER))
 static uint32_t crc32_shift_arm(uint32_t crc1, uint32_t n) {
@@ -211,15 +263,129 @@ static uint32_t crc32_shift_arm(uint32_t crc1, uint32_t n) {
 #endif
 
 
+#ifdef YENC_ENABLE_EXPERIMENTAL_KERNELS
+// CRC32C (Castagnoli) uses the same extension, but hasn't been verified on real hardware, so is only built with ENABLE_EXPERIMENTAL_KERNELS
+#ifdef __aarch64__
+# define CRC32C_WORD(crc, data) __crc32cd(crc, _LE64(data))
+#else
+# define CRC32C_WORD(crc, data) __crc32cw(crc, _LE32(data))
+#endif
+
+// same as arm_crc_calc, minus the pipelining experiment
+static uint32_t arm_crc32c_calc(uint32_t crc, const unsigned char *src, long len) {
+	if (len >= 16) {
+		if ((uintptr_t)src & sizeof(uint8_t)) {
+			crc = __crc32cb(crc, *src);
+			src++;
+			len--;
+		}
+		if ((uintptr_t)src & sizeof(uint16_t)) {
+			crc = __crc32ch(crc, _LE16(*((uint16_t *)src)));
+			src += sizeof(uint16_t);
+			len -= sizeof(uint16_t);
+		}
+#ifdef __aarch64__
+		if ((uintptr_t)src & sizeof(uint32_t)) {
+			crc = __crc32cw(crc, _LE32(*((uint32_t *)src)));
+			src += sizeof(uint32_t);
+			len -= sizeof(uint32_t);
+		}
+#endif
+	}
+	
+	const WORD_T* srcW = (const WORD_T*)src;
+	while ((len -= sizeof(WORD_T)*4) >= 0) {
+		crc = CRC32C_WORD(crc, *(srcW++));
+		crc = CRC32C_WORD(crc, *(srcW++));
+		crc = CRC32C_WORD(crc, *(srcW++));
+		crc = CRC32C_WORD(crc, *(srcW++));
+	}
+	if (len & sizeof(WORD_T)*2) {
+		crc = CRC32C_WORD(crc, *(srcW++));
+		crc = CRC32C_WORD(crc, *(srcW++));
+	}
+	if (len & sizeof(WORD_T)) {
+		crc = CRC32C_WORD(crc, *(srcW++));
+	}
+	src = (const unsigned char*)srcW;
+	
+#ifdef __aarch64__
+	if (len & sizeof(uint32_t)) {
+		crc = __crc32cw(crc, _LE32(*((uint32_t *)src)));
+		src += sizeof(uint32_t);
+	}
+#endif
+	if (len & sizeof(uint16_t)) {
+		crc = __crc32ch(crc, _LE16(*((uint16_t *)src)));
+		src += sizeof(uint16_t);
+	}
+	if (len & sizeof(uint8_t))
+		crc = __crc32cb(crc, *src);
+	
+	return crc;
+}
+
+static uint32_t do_crc32c_incremental_arm(const void* data, size_t length, uint32_t init) {
+	return ~arm_crc32c_calc(~init, (const unsigned char*)data, (long)length);
+}
+
+#ifdef __aarch64__
+static uint32_t crc32c_multiply_arm(uint32_t a, uint32_t b) {
+	uint64_t res = 0;
+	uint64_t a64 = (uint64_t)a << 32;
+	int64_t b64 = (int64_t)b << 32;
+	for(int i=0; i<32; i++) {
+		res ^= a64 & (b64 >> 63);
+		b64 += b64;
+		a64 >>= 1;
+	}
+	res = __crc32cw(0, res) ^ (res >> 32);
+	return res;
+}
+# if defined(__GNUC__) || defined(_MSC_VER)
+static uint32_t crc32c_shift_arm(uint32_t crc1, uint32_t n) {
+	uint32_t result = crc1;
+	uint64_t prod = result;
+	prod <<= 32 - (n&31);
+	result = __crc32cw(0, prod) ^ (prod >> 32);
+	n &= ~31;
+	
+	while(n) {
+		result = crc32c_multiply_arm(result, RapidYenc::crc32c_power[ctz32(n)]);
+		n &= n-1;
+	}
+	return result;
+}
+# endif
+#endif
+#endif
+
+
 void RapidYenc::crc_arm_set_funcs() {
 	_do_crc32_incremental = &do_crc32_incremental_arm;
+#ifdef YENC_ENABLE_EXPERIMENTAL_KERNELS
+	// hasn't been verified on real hardware yet
+	_do_crc32_multi = &do_crc32_multi_arm;
+#endif
 #ifdef __aarch64__
 	_crc32_multiply = &crc32_multiply_arm;
 # if defined(__GNUC__) || defined(_MSC_VER)
 	_crc32_shift = &crc32_shift_arm;
 # endif
+	_crc32_shift_many = &crc32_shift_many_arm;
 #endif
 	_crc32_isa = ISA_FEATURE_CRC;
+	
+#ifdef YENC_ENABLE_EXPERIMENTAL_KERNELS
+	_do_crc32c_incremental = &do_crc32c_incremental_arm;
+# ifdef __aarch64__
+	_crc32c_multiply = &crc32c_multiply_arm;
+#  if defined(__GNUC__) || defined(_MSC_VER)
+	_crc32c_shift = &crc32c_shift_arm;
+#  endif
+# endif
+	_crc32c_isa = ISA_FEATURE_CRC;
+#endif
 }
 #else
 void RapidYenc::crc_arm_set_funcs() {}
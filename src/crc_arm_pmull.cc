@@ -124,6 +124,15 @@ static uint32_t crc32_multiply_pmull(uint32_t a, uint32_t b) {
 	#endif
 }
 
+struct crc_mul_pmull {
+	static HEDLEY_ALWAYS_INLINE uint32_t mul(uint32_t a, uint32_t b) {
+		return crc32_multiply_pmull(a, b);
+	}
+};
+static void crc32_shift_many_pmull(uint32_t* crc, const uint32_t* n, size_t count) {
+	RapidYenc::crc32_shift_many_table<crc_mul_pmull>(crc, n, count);
+}
+
 
 
 static const uint32_t crc_power_rev[32] = { // bit-reversed crc_power
@@ -204,9 +213,103 @@ static uint32_t crc32_shift_pmull(uint32_t crc1, uint32_t n) {
 }
 
 
+#if defined(__aarch64__) && defined(YENC_ENABLE_EXPERIMENTAL_KERNELS)
+// bulk CRC via folding, as done in crc_folding.cc for x86
+// the CRC instructions form a serial dependency chain, whilst folding allows multiple independent multiplies to be in flight
+// this hasn't yet been verified on real hardware, so is only used if built with ENABLE_EXPERIMENTAL_KERNELS; otherwise the CRC instructions in crc_arm.cc are used
+
+# if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+#  define LOAD_LE128(p) vreinterpretq_u64_u8(vrev64q_u8(vld1q_u8(p)))
+#  define _LE64 __builtin_bswap64
+# else
+#  define LOAD_LE128(p) vreinterpretq_u64_u8(vld1q_u8(p))
+#  define _LE64(x) (x)
+# endif
+
+// (src.lo * k.lo) ^ (src.hi * k.hi) ^ data
+static HEDLEY_ALWAYS_INLINE uint64x2_t crc_fold_pmull(uint64x2_t src, uint64x2_t k, uint64x2_t data) {
+	uint64x2_t lo = pmull_low(vget_low_u64(src), vget_low_u64(k));
+	uint64x2_t hi = pmull_high(src, k);
+# ifdef __ARM_FEATURE_SHA3
+	return veor3q_u64(lo, hi, data);
+# else
+	return veorq_u64(veorq_u64(lo, hi), data);
+# endif
+}
+
+// constants are the same as those in crc_folding.cc
+ALIGN_TO(16, static const uint64_t crc_fold_k[4]) = {
+	0x154442bd4, 0x1c6e41596, // fold by 512 bits
+	0x1751997d0, 0x0ccaa009e  // fold by 128 bits
+};
+
+// below this, the setup/merge cost of folding outweighs its benefit over the CRC instructions
+#define CRC_FOLD_MIN 256
+
+static uint32_t crc_fold_calc(uint32_t crc, const unsigned char* src, long len) {
+	if(len >= CRC_FOLD_MIN) {
+		// align to 16 bytes; this is at most 15 bytes, so isn't worth doing in larger units
+		while((uintptr_t)src & 15) {
+			crc = __crc32b(crc, *src++);
+			len--;
+		}
+		
+		// merge in the initial CRC, as described in crc32_fold_finish
+		uint64x2_t x0 = veorq_u64(LOAD_LE128(src), vcombine_u64(vcreate_u64(crc), vcreate_u64(0)));
+		uint64x2_t x1 = LOAD_LE128(src + 16);
+		uint64x2_t x2 = LOAD_LE128(src + 32);
+		uint64x2_t x3 = LOAD_LE128(src + 48);
+		src += 64;
+		len -= 64;
+		
+		uint64x2_t k = vld1q_u64(crc_fold_k);
+		while(len >= 64) {
+			x0 = crc_fold_pmull(x0, k, LOAD_LE128(src));
+			x1 = crc_fold_pmull(x1, k, LOAD_LE128(src + 16));
+			x2 = crc_fold_pmull(x2, k, LOAD_LE128(src + 32));
+			x3 = crc_fold_pmull(x3, k, LOAD_LE128(src + 48));
+			src += 64;
+			len -= 64;
+		}
+		
+		// merge the four lanes into one
+		k = vld1q_u64(crc_fold_k + 2);
+		x0 = crc_fold_pmull(x0, k, x1);
+		x0 = crc_fold_pmull(x0, k, x2);
+		x0 = crc_fold_pmull(x0, k, x3);
+		
+		// the 128 bits left have the same CRC as all the data folded into them, so the CRC instructions can reduce them
+		crc = __crc32d(0, vgetq_lane_u64(x0, 0));
+		crc = __crc32d(crc, vgetq_lane_u64(x0, 1));
+	}
+	
+	while(len >= (long)sizeof(uint64_t)) {
+		uint64_t v;
+		memcpy(&v, src, sizeof(v));
+		crc = __crc32d(crc, _LE64(v));
+		src += sizeof(uint64_t);
+		len -= sizeof(uint64_t);
+	}
+	while(len--)
+		crc = __crc32b(crc, *src++);
+	return crc;
+}
+# undef LOAD_LE128
+# undef _LE64
+
+static uint32_t do_crc32_incremental_pmull(const void* data, size_t length, uint32_t init) {
+	return ~crc_fold_calc(~init, (const unsigned char*)data, (long)length);
+}
+#endif
+
+
 void RapidYenc::crc_pmull_set_funcs() {
+#if defined(__aarch64__) && defined(YENC_ENABLE_EXPERIMENTAL_KERNELS)
+	_do_crc32_incremental = &do_crc32_incremental_pmull;
+#endif
 	_crc32_multiply = &crc32_multiply_pmull;
 	_crc32_shift = &crc32_shift_pmull;
+	_crc32_shift_many = &crc32_shift_many_pmull;
 	_crc32_isa |= ISA_FEATURE_PMULL;
 }
 
@@ -15,12 +15,107 @@ static HEDLEY_ALWAYS_INLINE unsigned ctz32(uint32_t n) {
 namespace RapidYenc {
 	void crc_clmul_set_funcs();
 	void crc_clmul256_set_funcs();
+	void crc_clmul512_set_funcs();
 	void crc_arm_set_funcs();
 	void crc_pmull_set_funcs();
 	void crc_riscv_set_funcs();
+	void crc_riscv_zvbc_set_funcs();
+	void crc32c_sse42_set_funcs();
 	
 	extern const uint32_t crc_power[32];
+	extern uint32_t crc_power_byte[4][256]; // crc_power_byte[k][b] = x^(b * 2^(8k)), filled by crc32_init
 	uint32_t crc32_multiply_generic(uint32_t a, uint32_t b);
 	uint32_t crc32_shift_generic(uint32_t crc1, uint32_t n);
+	extern const uint32_t crc32c_power[32];
+	uint32_t crc32c_multiply_generic(uint32_t a, uint32_t b);
+	uint32_t crc32c_shift_generic(uint32_t crc1, uint32_t n);
+	void crc32_multi_generic(const void* const* data, const size_t* length, uint32_t* crc, size_t count);
+	void crc32_shift_many_generic(uint32_t* crc, const uint32_t* n, size_t count);
+	
+	// computes the CRCs of many buffers, interleaving `Kernel::LANES` of them so that the latency of each step is hidden behind the others
+	// when a buffer completes, its lane is refilled with the next one; once too few buffers remain to fill every lane, the rest are finished individually
+	// Kernel must define:
+	// - state: the per-lane accumulator
+	// - LANES: the number of buffers processed together
+	// - BLOCK: the number of bytes consumed from each lane per step
+	// - MIN_LENGTH: buffers shorter than this (at least BLOCK) are computed directly, rather than being given a lane
+	// - start(state&, src): begins a lane with an initial CRC of 0, consuming its first BLOCK bytes
+	// - run(state*, src*, steps): consumes `steps` blocks from every lane, advancing their pointers
+	// - finish(state&, src, len): returns the lane's CRC, after processing the `len` bytes left at `src`
+	template<class Kernel>
+	static void crc32_multi_lockstep(const void* const* data, const size_t* length, uint32_t* crc, size_t count) {
+		const unsigned LANES = Kernel::LANES;
+		typename Kernel::state state[LANES];
+		const uint8_t* src[LANES];
+		size_t blocks[LANES]; // whole blocks left in the lane
+		size_t idx[LANES];
+		unsigned active = 0;
+		size_t next = 0;
+		
+		while(1) {
+			// fill empty lanes
+			for(; active < LANES && next < count; next++) {
+				if(length[next] < Kernel::MIN_LENGTH) {
+					crc[next] = crc32(data[next], length[next], 0);
+					continue;
+				}
+				src[active] = (const uint8_t*)data[next];
+				Kernel::start(state[active], src[active]);
+				src[active] += Kernel::BLOCK;
+				blocks[active] = length[next] / Kernel::BLOCK - 1;
+				idx[active] = next;
+				active++;
+			}
+			if(active < LANES) break;
+			
+			size_t steps = blocks[0];
+			for(unsigned lane=1; lane<LANES; lane++)
+				if(blocks[lane] < steps) steps = blocks[lane];
+			Kernel::run(state, src, steps);
+			
+			// retire completed buffers, moving the last lane into the gap
+			for(unsigned lane=0; lane<LANES; lane++)
+				blocks[lane] -= steps;
+			for(unsigned lane=0; lane<active; ) {
+				if(blocks[lane]) {
+					lane++;
+					continue;
+				}
+				size_t i = idx[lane];
+				crc[i] = Kernel::finish(state[lane], src[lane], length[i] % Kernel::BLOCK);
+				active--;
+				state[lane] = state[active];
+				src[lane] = src[active];
+				blocks[lane] = blocks[active];
+				idx[lane] = idx[active];
+			}
+		}
+		
+		for(unsigned lane=0; lane<active; lane++) {
+			size_t i = idx[lane];
+			crc[i] = Kernel::finish(state[lane], src[lane], blocks[lane] * Kernel::BLOCK + length[i] % Kernel::BLOCK);
+		}
+	}
+	
+	// computes `crc[i] = crc32_shift(crc[i], n[i])` for many values
+	// each exponent is split into bytes, so the shift is always three multiplies of looked up powers, plus one to apply it; with no dependency between values, their multiplies can overlap
+	// Mul must define `mul(a, b)`, a multiply in the CRC32 field, which should be inlinable
+	template<class Mul>
+	static void crc32_shift_many_table(uint32_t* crc, const uint32_t* n, size_t count) {
+		for(size_t i=0; i<count; i++) {
+			uint32_t e = n[i];
+			uint32_t lo = Mul::mul(crc_power_byte[0][e & 0xff], crc_power_byte[1][(e >> 8) & 0xff]);
+			uint32_t hi = Mul::mul(crc_power_byte[2][(e >> 16) & 0xff], crc_power_byte[3][e >> 24]);
+			crc[i] = Mul::mul(crc[i], Mul::mul(lo, hi));
+		}
+	}
+	
+	// folding kernels merge the initial CRC into the data, by XORing its inverse into the first 4 bytes; with CRC32's pre/post inversion, the accumulator left after folding then has the same CRC as all the data folded into it, computed with an `init` of 0xffffffff (i.e. no initial value)
+	// this finishes such a kernel: `buf` holds the `accLen` byte accumulator, with space after it for the `tailLen` bytes at `tail` which weren't folded in; these are appended, so that a single call to `calc` (typically a narrower kernel) reduces everything
+	template<typename Calc>
+	static HEDLEY_ALWAYS_INLINE uint32_t crc32_fold_finish(Calc calc, uint8_t* buf, size_t accLen, const void* tail, size_t tailLen) {
+		memcpy(buf + accLen, tail, tailLen);
+		return calc(buf, accLen + tailLen, 0xffffffff);
+	}
 	
 }
\ No newline at end of file
@@ -355,6 +355,62 @@ static uint32_t do_crc32_incremental_clmul(const void* data, size_t length, uint
 	return crc_fold((const unsigned char*)data, (long)length, init);
 }
 
+// multi-buffer CRC: each buffer gets a single accumulator, folded 16 bytes at a time
+struct crc_multi_clmul {
+	typedef __m128i state;
+	static const unsigned LANES = 4;
+	static const size_t BLOCK = 16;
+	// crc_fold already hides latency with four accumulators, so interleaving buffers only helps once they're large enough to stream from memory
+	static const size_t MIN_LENGTH = 4096;
+	
+	static HEDLEY_ALWAYS_INLINE void start(__m128i& crc, const uint8_t* src) {
+		// merge in an initial CRC of 0, as described in crc32_fold_finish
+		crc = _mm_xor_si128(_mm_loadu_si128((__m128i*)src), _mm_cvtsi32_si128(-1));
+	}
+	static HEDLEY_ALWAYS_INLINE void run(__m128i* state, const uint8_t** src, size_t steps) {
+		const __m128i xmm_fold1 = _mm_load_si128((__m128i *)crc_k);
+		// copy lanes to locals, so that they can be kept in registers
+		__m128i crc0 = state[0], crc1 = state[1], crc2 = state[2], crc3 = state[3];
+		const uint8_t *src0 = src[0], *src1 = src[1], *src2 = src[2], *src3 = src[3];
+		for(size_t i=0; i<steps*BLOCK; i+=BLOCK) {
+#ifdef ENABLE_AVX512
+			#define DO_FOLD(n) crc##n = _mm_ternarylogic_epi32( \
+				_mm_clmulepi64_si128(crc##n, xmm_fold1, 0x01), \
+				_mm_clmulepi64_si128(crc##n, xmm_fold1, 0x10), \
+				_mm_loadu_si128((__m128i*)(src##n + i)), \
+				0x96 \
+			)
+#else
+			// XOR the data in first, to shorten the dependency chain
+			#define DO_FOLD(n) crc##n = fold_xor( \
+				_mm_clmulepi64_si128(crc##n, xmm_fold1, 0x01), \
+				fold_xor(_mm_clmulepi64_si128(crc##n, xmm_fold1, 0x10), _mm_loadu_si128((__m128i*)(src##n + i))) \
+			)
+#endif
+			DO_FOLD(0);
+			DO_FOLD(1);
+			DO_FOLD(2);
+			DO_FOLD(3);
+			#undef DO_FOLD
+		}
+		state[0] = crc0; state[1] = crc1; state[2] = crc2; state[3] = crc3;
+		src[0] = src0 + steps*BLOCK;
+		src[1] = src1 + steps*BLOCK;
+		src[2] = src2 + steps*BLOCK;
+		src[3] = src3 + steps*BLOCK;
+	}
+	static HEDLEY_ALWAYS_INLINE uint32_t finish(__m128i crc, const uint8_t* src, size_t len) {
+		ALIGN_TO(16, uint8_t acc[32]);
+		_mm_store_si128((__m128i*)acc, crc);
+		if(len < BLOCK) // usual case: only one reduction is needed
+			return RapidYenc::crc32_fold_finish(crc_fold, acc, 16, src, len);
+		return crc_fold(src, (long)len, crc_fold(acc, 16, 0xffffffff));
+	}
+};
+static void do_crc32_multi_clmul(const void* const* data, const size_t* length, uint32_t* crc, size_t count) {
+	RapidYenc::crc32_multi_lockstep<crc_multi_clmul>(data, length, crc, count);
+}
+
 
 static HEDLEY_ALWAYS_INLINE __m128i crc32_reduce(__m128i prod) {
 	// do Barrett reduction back into 32-bit field
@@ -377,6 +433,15 @@ static uint32_t crc32_multiply_clmul(uint32_t a, uint32_t b) {
 	return _mm_extract_epi32(prod, 2);
 }
 
+struct crc_mul_clmul {
+	static HEDLEY_ALWAYS_INLINE uint32_t mul(uint32_t a, uint32_t b) {
+		return crc32_multiply_clmul(a, b);
+	}
+};
+static void crc32_shift_many_clmul(uint32_t* crc, const uint32_t* n, size_t count) {
+	RapidYenc::crc32_shift_many_table<crc_mul_clmul>(crc, n, count);
+}
+
 #if defined(__GNUC__) || defined(_MSC_VER)
 static HEDLEY_ALWAYS_INLINE __m128i reverse_bits_epi8(__m128i src) {
 #if defined(__GFNI__) && defined(YENC_BUILD_NATIVE) && YENC_BUILD_NATIVE!=0
@@ -501,10 +566,12 @@ static uint32_t crc32_shift_clmul(uint32_t crc1, uint32_t n) {
 
 void RapidYenc::crc_clmul_set_funcs() {
 	_do_crc32_incremental = &do_crc32_incremental_clmul;
+	_do_crc32_multi = &do_crc32_multi_clmul;
 	_crc32_multiply = &crc32_multiply_clmul;
 #if defined(__GNUC__) || defined(_MSC_VER)
 	_crc32_shift = &crc32_shift_clmul;
 #endif
+	_crc32_shift_many = &crc32_shift_many_clmul;
 	_crc32_isa = ISA_LEVEL_PCLMUL;
 }
 #else
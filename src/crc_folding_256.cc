@@ -213,6 +213,7 @@ static uint32_t do_crc32_incremental_clmul(const void* data, size_t length, uint
 void RapidYenc::crc_clmul256_set_funcs() {
 	crc_clmul_set_funcs(); // set multiply/shift function
 	_do_crc32_incremental = &do_crc32_incremental_clmul;
+	_do_crc32_multi = &crc32_multi_generic; // the wider kernel is faster than interleaving 128-bit folds across buffers
 	_crc32_isa = ISA_LEVEL_VPCLMUL;
 }
 #else
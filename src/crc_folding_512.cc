@@ -0,0 +1,81 @@
+// 512-bit version of crc_folding
+// data is folded 256 bytes at a time into four ZMM accumulators; short inputs and the final reduction are left to the 256-bit version
+
+#include "crc_common.h"
+
+#if !defined(YENC_DISABLE_AVX256) && ((defined(__VPCLMULQDQ__) && defined(__AVX512F__) && defined(__PCLMUL__) && (defined(__EVEX512__) || !(defined(__AVX10_1__) || defined(__EVEX256__)))) || (defined(_MSC_VER) && _MSC_VER >= 1920 && defined(PLATFORM_X86) && !defined(__clang__)))
+#include <inttypes.h>
+#include <immintrin.h>
+
+
+// 256-bit implementation, used for short lengths and the final reduction
+static RapidYenc::crc_func do_crc32_incremental_short;
+
+static HEDLEY_ALWAYS_INLINE __m512i do_one_fold(__m512i src, __m512i fold, __m512i data) {
+	return _mm512_ternarylogic_epi32(
+	  _mm512_clmulepi64_epi128(src, fold, 0x01),
+	  _mm512_clmulepi64_epi128(src, fold, 0x10),
+	  data,
+	  0x96
+	);
+}
+
+static uint32_t do_crc32_incremental_clmul512(const void* data, size_t length, uint32_t init) {
+	const unsigned char* src = (const unsigned char*)data;
+	if(length < 256) // not enough to fill all four accumulators
+		return do_crc32_incremental_short(src, length, init);
+	
+	// merge in the initial CRC, as described in crc32_fold_finish
+	__m512i crc0 = _mm512_loadu_si512(src);
+	crc0 = _mm512_mask_xor_epi32(crc0, 1, crc0, _mm512_set1_epi32(~init));
+	__m512i crc1 = _mm512_loadu_si512(src + 64);
+	__m512i crc2 = _mm512_loadu_si512(src + 128);
+	__m512i crc3 = _mm512_loadu_si512(src + 192);
+	src += 256;
+	length -= 256;
+	
+	const __m512i fold16 = _mm512_maskz_broadcast_i32x4(0xffff, _mm_set_epi32(
+		0x00000001, 0x1542778a,
+		0x00000001, 0x322d1430
+	));
+	while(length >= 256) {
+		crc0 = do_one_fold(crc0, fold16, _mm512_loadu_si512(src));
+		crc1 = do_one_fold(crc1, fold16, _mm512_loadu_si512(src + 64));
+		crc2 = do_one_fold(crc2, fold16, _mm512_loadu_si512(src + 128));
+		crc3 = do_one_fold(crc3, fold16, _mm512_loadu_si512(src + 192));
+		src += 256;
+		length -= 256;
+	}
+	
+	// merge the four accumulators into one, then fold in any remaining 64-byte blocks
+	const __m512i fold4 = _mm512_maskz_broadcast_i32x4(0xffff, _mm_set_epi32(
+		0x00000001, 0x54442bd4,
+		0x00000001, 0xc6e41596
+	));
+	crc0 = do_one_fold(crc0, fold4, crc1);
+	crc0 = do_one_fold(crc0, fold4, crc2);
+	crc0 = do_one_fold(crc0, fold4, crc3);
+	while(length >= 64) {
+		crc0 = do_one_fold(crc0, fold4, _mm512_loadu_si512(src));
+		src += 64;
+		length -= 64;
+	}
+	
+	// the reduction is left to the 256-bit version
+	ALIGN_TO(64, uint8_t tail[128]);
+	_mm512_store_si512(tail, crc0);
+	return RapidYenc::crc32_fold_finish(do_crc32_incremental_short, tail, 64, src, length);
+}
+
+void RapidYenc::crc_clmul512_set_funcs() {
+	crc_clmul256_set_funcs();
+	do_crc32_incremental_short = _do_crc32_incremental;
+	_do_crc32_incremental = &do_crc32_incremental_clmul512;
+	_crc32_isa = ISA_LEVEL_VPCLMUL | ISA_FEATURE_EVEX512;
+}
+#else
+void RapidYenc::crc_clmul512_set_funcs() {
+	crc_clmul256_set_funcs();
+}
+#endif
+
@@ -0,0 +1,49 @@
+#include "crc_common.h"
+#include "parallel.h"
+
+namespace RapidYenc {
+	struct crc_parallel_job {
+		const unsigned char* src;
+		size_t len;
+		size_t chunkSize;
+		size_t numChunks;
+		uint32_t* crcs;
+	};
+}
+
+static void crc_parallel_task(void* data, size_t index) {
+	RapidYenc::crc_parallel_job* job = (RapidYenc::crc_parallel_job*)data;
+	size_t offset = index * job->chunkSize;
+	size_t len = (index == job->numChunks-1) ? job->len - offset : job->chunkSize;
+	job->crcs[index] = RapidYenc::crc32(job->src + offset, len, 0);
+}
+
+uint32_t RapidYenc::crc32_parallel(const void* src, size_t len, uint32_t init, size_t numChunks, task_runner runner, void* pool) {
+	if(numChunks < 2) numChunks = 1;
+	
+	size_t chunkSize = ((len / numChunks) + 63) & ~(size_t)63;
+	if(chunkSize < PARALLEL_MIN_CHUNK) chunkSize = PARALLEL_MIN_CHUNK;
+	numChunks = (len + chunkSize-1) / chunkSize;
+	if(numChunks < 2)
+		return crc32(src, len, init);
+	
+	crc_parallel_job job;
+	job.crcs = (uint32_t*)malloc(numChunks * sizeof(uint32_t));
+	if(!job.crcs) // can't do this in parallel, fall back to a serial CRC
+		return crc32(src, len, init);
+	job.src = (const unsigned char*)src;
+	job.len = len;
+	job.chunkSize = chunkSize;
+	job.numChunks = numChunks;
+	
+	run_tasks(runner, pool, &crc_parallel_task, &job, numChunks);
+	
+	// join the chunks' CRCs together; all chunks but the last are the same length, so the shift amount only needs to be computed once
+	uint32_t chunkPow = crc32_bytepow(chunkSize);
+	uint32_t crc = init;
+	for(size_t i=0; i<numChunks-1; i++)
+		crc = crc32_shift(crc, chunkPow) ^ job.crcs[i];
+	crc = crc32_combine(crc, job.crcs[numChunks-1], len - (numChunks-1)*chunkSize);
+	free(job.crcs);
+	return crc;
+}
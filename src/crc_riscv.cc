@@ -208,6 +208,15 @@ static uint32_t crc32_multiply_rv_zbc(uint32_t a, uint32_t b) {
 	return t;
 }
 
+struct crc_mul_rv_zbc {
+	static HEDLEY_ALWAYS_INLINE uint32_t mul(uint32_t a, uint32_t b) {
+		return crc32_multiply_rv_zbc(a, b);
+	}
+};
+static void crc32_shift_many_rv_zbc(uint32_t* crc, const uint32_t* n, size_t count) {
+	RapidYenc::crc32_shift_many_table<crc_mul_rv_zbc>(crc, n, count);
+}
+
 #if defined(__GNUC__) || defined(_MSC_VER)
 static uint32_t crc32_shift_rv_zbc(uint32_t crc1, uint32_t n) {
 	// TODO: require Zbb for ctz
@@ -244,6 +253,7 @@ void RapidYenc::crc_riscv_set_funcs() {
 #if defined(__GNUC__) || defined(_MSC_VER)
 	_crc32_shift = &crc32_shift_rv_zbc;
 #endif
+	_crc32_shift_many = &crc32_shift_many_rv_zbc;
 	_crc32_isa = ISA_FEATURE_ZBC;
 }
 #else
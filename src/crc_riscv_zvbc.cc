@@ -0,0 +1,70 @@
+// vector variant of crc_riscv, using Zvbc's carry-less multiply
+// data is folded 128 bytes at a time, as eight 128-bit lanes; short inputs and the final reduction are left to the scalar version
+// this hasn't yet been verified on real hardware or under emulation, so it's only built if ENABLE_EXPERIMENTAL_KERNELS is enabled
+
+#include "crc_common.h"
+
+#if defined(__riscv_vector) && defined(__riscv_zvbc) && defined(__riscv_v_intrinsic) && __riscv_v_intrinsic >= 12000
+
+// scalar implementation, used for short lengths and the final reduction
+static RapidYenc::crc_func do_crc32_incremental_short;
+
+// each 128-bit lane is held as separate vectors of its low and high halves, so that both halves can be multiplied by their respective constants without needing to shuffle
+static HEDLEY_ALWAYS_INLINE void do_one_fold(vuint64m4_t& lo, vuint64m4_t& hi, const uint8_t* src, size_t vl) {
+	// constants for folding by 128 bytes: x^(1056-1) for the low half, x^(992-1) for the high half
+	const uint64_t MUL_LO = 0x1e88ef372, MUL_HI = 0x14a7fe880;
+	vuint64m4x2_t data = RV(vlseg2e64_v_u64m4x2)((const uint64_t*)src, vl);
+	vuint64m4_t newLo = RV(vxor_vv_u64m4)(
+		RV(vclmul_vx_u64m4)(lo, MUL_LO, vl),
+		RV(vclmul_vx_u64m4)(hi, MUL_HI, vl),
+		vl
+	);
+	vuint64m4_t newHi = RV(vxor_vv_u64m4)(
+		RV(vclmulh_vx_u64m4)(lo, MUL_LO, vl),
+		RV(vclmulh_vx_u64m4)(hi, MUL_HI, vl),
+		vl
+	);
+	lo = RV(vxor_vv_u64m4)(newLo, RV(vget_v_u64m4x2_u64m4)(data, 0), vl);
+	hi = RV(vxor_vv_u64m4)(newHi, RV(vget_v_u64m4x2_u64m4)(data, 1), vl);
+}
+
+static uint32_t do_crc32_incremental_rv_zvbc(const void* data, size_t length, uint32_t init) {
+	const uint8_t* src = (const uint8_t*)data;
+	if(length < 256) // not worth setting up the vectors for
+		return do_crc32_incremental_short(src, length, init);
+	
+	// V guarantees VLEN >= 128, so an LMUL=4 group always fits the 8 lanes
+	const size_t vl = RV(vsetvl_e64m4)(8);
+	
+	// merge in the initial CRC, as described in crc32_fold_finish
+	vuint64m4x2_t first = RV(vlseg2e64_v_u64m4x2)((const uint64_t*)src, vl);
+	vuint64m4_t lo = RV(vxor_vv_u64m4)(
+		RV(vget_v_u64m4x2_u64m4)(first, 0),
+		RV(vmv_s_x_u64m4_tu)(RV(vmv_v_x_u64m4)(0, vl), (uint32_t)~init, vl),
+		vl
+	);
+	vuint64m4_t hi = RV(vget_v_u64m4x2_u64m4)(first, 1);
+	src += 128;
+	length -= 128;
+	
+	while(length >= 128) {
+		do_one_fold(lo, hi, src, vl);
+		src += 128;
+		length -= 128;
+	}
+	
+	// the reduction is left to the scalar version
+	uint64_t tail[32];
+	RV(vsse64_v_u64m4)(tail, 16, lo, vl);
+	RV(vsse64_v_u64m4)(tail + 1, 16, hi, vl);
+	return RapidYenc::crc32_fold_finish(do_crc32_incremental_short, (uint8_t*)tail, 128, src, length);
+}
+
+void RapidYenc::crc_riscv_zvbc_set_funcs() {
+	do_crc32_incremental_short = _do_crc32_incremental;
+	_do_crc32_incremental = &do_crc32_incremental_rv_zvbc;
+	_crc32_isa = ISA_FEATURE_ZVBC;
+}
+#else
+void RapidYenc::crc_riscv_zvbc_set_funcs() {}
+#endif
@@ -0,0 +1,238 @@
+#include "crc_common.h"
+
+// sliding window CRC32, using the same approach as crcutil's RollingCrc: as the window advances by one byte, the incoming byte is hashed as usual, whilst the outgoing byte's contribution (which has been multiplied by x^(8*window) since it entered) is cancelled out via a lookup table
+void RapidYenc::crc32_rolling_init(crc_rolling* roll, size_t window) {
+	roll->window = window;
+	for(int i=0; i<256; i++) {
+		uint32_t crc = i;
+		for(int j=0; j<8; j++)
+			crc = (crc >> 1) ^ (0xEDB88320 & -(crc & 1));
+		roll->in[i] = crc;
+	}
+	
+	// with pre/post inversion, the CRC of the window is `L(data) ^ K`, where L is the CRC without inversion and K = crc32_zeros(0, window)
+	// L rolls as `L' = (L >> 8) ^ in[(L ^ byteIn) & 0xff] ^ out[byteOut]`, where out[b] = L(b followed by `window` zeroes)
+	// as L is linear, substituting `crc ^ K` for it gives the same formula on the inverted CRC, with the constant `K*x^8 ^ K` folded into the out table
+	uint32_t k = crc32_zeros(0, window);
+	uint32_t add = crc32_shift(k, 8) ^ k;
+	uint32_t windowPow = crc32_bytepow(window);
+	for(int i=0; i<256; i++)
+		roll->out[i] = crc32_shift(roll->in[i], windowPow) ^ add;
+}
+
+
+namespace RapidYenc {
+	struct crc_target {
+		uint32_t crc;
+		size_t index;
+	};
+	// targets are sorted for binary search, with a bitmap on the low bits of the CRC to quickly reject most windows
+	struct crc_target_set {
+		const uint8_t* bitmap; // NULL if allocation failed, in which case targets are searched linearly
+		uint32_t mask; // the bitmap is indexed by `crc & mask`
+		const crc_target* sorted;
+		const uint32_t* targets;
+		size_t count;
+	};
+}
+
+static int crc_target_cmp(const void* a, const void* b) {
+	const RapidYenc::crc_target* ta = (const RapidYenc::crc_target*)a;
+	const RapidYenc::crc_target* tb = (const RapidYenc::crc_target*)b;
+	if(ta->crc != tb->crc) return ta->crc < tb->crc ? -1 : 1;
+	if(ta->index != tb->index) return ta->index < tb->index ? -1 : 1;
+	return 0;
+}
+
+static HEDLEY_ALWAYS_INLINE bool crc_target_maybe(const RapidYenc::crc_target_set& set, uint32_t crc) {
+	uint32_t bit = crc & set.mask;
+	return !set.bitmap || (set.bitmap[bit >> 3] & (1 << (bit & 7)));
+}
+
+// returns the lowest index of a target matching `crc`, or (size_t)-1 if there's none
+static size_t crc_target_find(const RapidYenc::crc_target_set& set, uint32_t crc) {
+	if(!set.bitmap) {
+		for(size_t i=0; i<set.count; i++)
+			if(set.targets[i] == crc) return i;
+		return (size_t)-1;
+	}
+	size_t lo = 0, hi = set.count;
+	while(lo < hi) {
+		size_t mid = lo + (hi-lo)/2;
+		if(set.sorted[mid].crc < crc)
+			lo = mid+1;
+		else
+			hi = mid;
+	}
+	if(lo < set.count && set.sorted[lo].crc == crc)
+		return set.sorted[lo].index;
+	return (size_t)-1;
+}
+
+// checks windows starting at offsets [start, end); returns the number of matches written
+static size_t crc_rolling_scan(const RapidYenc::crc_rolling* roll, const RapidYenc::crc_target_set& set, const unsigned char* src, size_t start, size_t end, RapidYenc::crc_rolling_match* matches, size_t maxMatches) {
+	size_t numMatches = 0;
+	if(start >= end || !maxMatches) return 0;
+	uint32_t crc = RapidYenc::crc32(src + start, roll->window, 0);
+	for(size_t pos=start; ; ) {
+		if(HEDLEY_UNLIKELY(crc_target_maybe(set, crc))) {
+			size_t index = crc_target_find(set, crc);
+			if(index != (size_t)-1) {
+				matches[numMatches].offset = pos;
+				matches[numMatches].target = index;
+				if(++numMatches == maxMatches) break;
+			}
+		}
+		if(++pos == end) break;
+		crc = RapidYenc::crc32_roll(roll, crc, src[pos-1], src[pos-1 + roll->window]);
+	}
+	return numMatches;
+}
+
+
+// each roll is dependent on the previous, so a single window is limited by the latency of the table lookup; to keep the CPU busy, several windows, each starting in a different part of the buffer, are rolled in lockstep
+#define ROLLING_STREAMS 4 // the main loop is written out for this many streams
+#define ROLLING_MIN_SEGMENT 4096
+// streams after the first can't write directly to the output (as their matches come later), so buffer them; if one overflows, everything from that point onwards is rescanned with a single stream
+#define ROLLING_STREAM_BUFFER 64
+
+namespace RapidYenc {
+	struct crc_rolling_streams {
+		const crc_target_set* set;
+		size_t segment;
+		crc_rolling_match* matches;
+		size_t numMatches;
+		size_t maxMatches;
+		size_t bufCount[ROLLING_STREAMS-1];
+		size_t overflowPos[ROLLING_STREAMS-1];
+		crc_rolling_match buffer[ROLLING_STREAMS-1][ROLLING_STREAM_BUFFER];
+	};
+}
+
+// handles a possible match on any stream; kept out of line so that the main loop stays small; returns true if the output is full
+static HEDLEY_NEVER_INLINE bool crc_rolling_streams_check(RapidYenc::crc_rolling_streams* st, size_t pos, const uint32_t* crcs) {
+	size_t index = crc_target_maybe(*st->set, crcs[0]) ? crc_target_find(*st->set, crcs[0]) : (size_t)-1;
+	if(index != (size_t)-1) {
+		st->matches[st->numMatches].offset = pos;
+		st->matches[st->numMatches].target = index;
+		if(++st->numMatches == st->maxMatches)
+			return true;
+	}
+	for(int s=1; s<ROLLING_STREAMS; s++) {
+		size_t& count = st->bufCount[s-1];
+		if(count > ROLLING_STREAM_BUFFER || !crc_target_maybe(*st->set, crcs[s])) continue; // skip if already overflowed
+		index = crc_target_find(*st->set, crcs[s]);
+		if(index == (size_t)-1) continue;
+		if(count == ROLLING_STREAM_BUFFER) {
+			st->overflowPos[s-1] = s*st->segment + pos;
+		} else {
+			st->buffer[s-1][count].offset = s*st->segment + pos;
+			st->buffer[s-1][count].target = index;
+		}
+		count++;
+	}
+	return false;
+}
+
+size_t RapidYenc::crc32_rolling_search(const crc_rolling* roll, const void* src, size_t len, const uint32_t* targets, size_t numTargets, crc_rolling_match* matches, size_t maxMatches) {
+	size_t window = roll->window;
+	if(!window || len < window || !numTargets || !maxMatches) return 0;
+	const unsigned char* data = (const unsigned char*)src;
+	size_t positions = len - window + 1;
+	
+	crc_target_set set;
+	set.targets = targets;
+	set.count = numTargets;
+	// size the bitmap to be fairly sparse (so false positives are rare), whilst keeping it small enough to stay in cache
+	unsigned bitmapBits = 16;
+	while(bitmapBits < 23 && ((size_t)1 << bitmapBits) < numTargets*1024)
+		bitmapBits++;
+	size_t bitmapSize = (size_t)1 << (bitmapBits-3);
+	set.mask = ((uint32_t)1 << bitmapBits) - 1;
+	crc_target* sorted = (crc_target*)malloc(bitmapSize + numTargets * sizeof(crc_target));
+	set.bitmap = (const uint8_t*)sorted;
+	if(sorted) {
+		uint8_t* bitmap = (uint8_t*)sorted;
+		sorted = (crc_target*)(bitmap + bitmapSize);
+		memset(bitmap, 0, bitmapSize);
+		for(size_t i=0; i<numTargets; i++) {
+			uint32_t bit = targets[i] & set.mask;
+			sorted[i].crc = targets[i];
+			sorted[i].index = i;
+			bitmap[bit >> 3] |= 1 << (bit & 7);
+		}
+		qsort(sorted, numTargets, sizeof(crc_target), &crc_target_cmp);
+	}
+	set.sorted = sorted;
+	
+	size_t numMatches = 0;
+	size_t resumePos = 0;
+	size_t segment = positions / ROLLING_STREAMS;
+	// computing the starting CRC of each stream requires hashing a whole window, so only split if that's small relative to the amount of rolling saved
+	if(set.bitmap && segment >= ROLLING_MIN_SEGMENT && segment >= window/8) {
+		crc_rolling_streams* st = (crc_rolling_streams*)malloc(sizeof(crc_rolling_streams));
+		if(st) {
+			st->set = &set;
+			st->segment = segment;
+			st->matches = matches;
+			st->numMatches = 0;
+			st->maxMatches = maxMatches;
+			memset(st->bufCount, 0, sizeof(st->bufCount));
+			
+			const uint8_t* bitmap = set.bitmap;
+			const uint32_t mask = set.mask;
+			const unsigned char* src1 = data + segment;
+			const unsigned char* src2 = data + segment*2;
+			const unsigned char* src3 = data + segment*3;
+			// keep each stream's state in a separate variable, so that they stay in registers
+			uint32_t crc0 = crc32(data, window, 0);
+			uint32_t crc1 = crc32(src1, window, 0);
+			uint32_t crc2 = crc32(src2, window, 0);
+			uint32_t crc3 = crc32(src3, window, 0);
+			
+			bool full = false;
+			for(size_t i=0; ; ) {
+				// test all streams at once, as a match on any is rare
+				uint32_t b0 = crc0 & mask, b1 = crc1 & mask, b2 = crc2 & mask, b3 = crc3 & mask;
+				int maybe = ((bitmap[b0 >> 3] >> (b0 & 7)) | (bitmap[b1 >> 3] >> (b1 & 7)) | (bitmap[b2 >> 3] >> (b2 & 7)) | (bitmap[b3 >> 3] >> (b3 & 7))) & 1;
+				if(HEDLEY_UNLIKELY(maybe)) {
+					uint32_t crcs[ROLLING_STREAMS] = {crc0, crc1, crc2, crc3};
+					if(crc_rolling_streams_check(st, i, crcs)) {
+						full = true;
+						break;
+					}
+				}
+				if(++i == segment) break;
+				crc0 = crc32_roll(roll, crc0, data[i-1], data[i-1 + window]);
+				crc1 = crc32_roll(roll, crc1, src1[i-1], src1[i-1 + window]);
+				crc2 = crc32_roll(roll, crc2, src2[i-1], src2[i-1 + window]);
+				crc3 = crc32_roll(roll, crc3, src3[i-1], src3[i-1 + window]);
+			}
+			numMatches = st->numMatches;
+			
+			// gather the buffered matches in order
+			resumePos = ROLLING_STREAMS * segment;
+			for(int s=1; s<ROLLING_STREAMS && !full; s++) {
+				size_t count = st->bufCount[s-1];
+				if(count > ROLLING_STREAM_BUFFER) count = ROLLING_STREAM_BUFFER;
+				for(size_t j=0; j<count; j++) {
+					matches[numMatches] = st->buffer[s-1][j];
+					if(++numMatches == maxMatches) {
+						full = true;
+						break;
+					}
+				}
+				if(!full && st->bufCount[s-1] > ROLLING_STREAM_BUFFER) {
+					resumePos = st->overflowPos[s-1];
+					break;
+				}
+			}
+			if(full) resumePos = positions;
+			free(st);
+		}
+	}
+	
+	numMatches += crc_rolling_scan(roll, set, data, resumePos, positions, matches + numMatches, maxMatches - numMatches);
+	free((void*)set.bitmap);
+	return numMatches;
+}
@@ -0,0 +1,96 @@
+// CRC32C using SSE4.2's CRC32 instruction
+// the instruction has a latency of 3 cycles, but can issue every cycle, so three independent streams are hashed at once, then merged using PCLMUL
+
+#include "crc_common.h"
+
+#if (defined(__SSE4_2__) && defined(__PCLMUL__)) || (defined(_MSC_VER) && _MSC_VER >= 1600 && defined(PLATFORM_X86) && !defined(__clang__))
+#include <nmmintrin.h>
+#include <wmmintrin.h>
+
+#if defined(__x86_64__) || defined(_M_X64)
+# define WORD_T uint64_t
+# define CRC_WORD(crc, data) (uint32_t)_mm_crc32_u64(crc, data)
+#else
+# define WORD_T uint32_t
+# define CRC_WORD(crc, data) _mm_crc32_u32(crc, data)
+#endif
+
+static HEDLEY_ALWAYS_INLINE WORD_T read_word(const unsigned char* src) {
+	WORD_T data;
+	memcpy(&data, src, sizeof(data));
+	return data;
+}
+
+static uint32_t crc32c_multiply_sse42(uint32_t a, uint32_t b) {
+	__m128i prod = _mm_clmulepi64_si128(_mm_cvtsi32_si128(a), _mm_cvtsi32_si128(b), 0);
+	prod = _mm_add_epi64(prod, prod); // bit alignment fix, due to CRC32 being bit-reversal
+	// reduction via CRC
+	return _mm_crc32_u32(0, _mm_cvtsi128_si32(prod)) ^ (uint32_t)_mm_extract_epi32(prod, 1);
+}
+
+// hashes as many groups of three BLOCK sized streams as possible; `power` is the index into crc32c_power for BLOCK
+template<size_t BLOCK, int power>
+static HEDLEY_ALWAYS_INLINE uint32_t crc_calc_3way(uint32_t crc, const unsigned char*& src, size_t& len) {
+	while(len >= BLOCK*3) {
+		uint32_t crc1 = 0, crc2 = 0;
+		for(size_t i=0; i<BLOCK; i+=sizeof(WORD_T)) {
+			crc = CRC_WORD(crc, read_word(src + i));
+			crc1 = CRC_WORD(crc1, read_word(src + BLOCK + i));
+			crc2 = CRC_WORD(crc2, read_word(src + BLOCK*2 + i));
+		}
+		// shift the first two streams over the following ones, and merge
+		crc = crc32c_multiply_sse42(crc, RapidYenc::crc32c_power[power+1])
+		    ^ crc32c_multiply_sse42(crc1, RapidYenc::crc32c_power[power])
+		    ^ crc2;
+		src += BLOCK*3;
+		len -= BLOCK*3;
+	}
+	return crc;
+}
+
+static uint32_t sse42_crc_calc(uint32_t crc, const unsigned char *src, size_t len) {
+	crc = crc_calc_3way<8192, 16>(crc, src, len); // 2^16 = 8192*8 bits
+	crc = crc_calc_3way<256, 11>(crc, src, len);
+	
+	for(; len >= sizeof(WORD_T); len -= sizeof(WORD_T)) {
+		crc = CRC_WORD(crc, read_word(src));
+		src += sizeof(WORD_T);
+	}
+	while(len--)
+		crc = _mm_crc32_u8(crc, *src++);
+	return crc;
+}
+
+static uint32_t do_crc32c_incremental_sse42(const void* data, size_t length, uint32_t init) {
+	return ~sse42_crc_calc(~init, (const unsigned char*)data, length);
+}
+
+
+#if defined(__GNUC__) || defined(_MSC_VER)
+static uint32_t crc32c_shift_sse42(uint32_t crc1, uint32_t n) {
+	uint32_t result = crc1;
+	uint64_t prod = result;
+	prod <<= 32 - (n&31);
+	result = _mm_crc32_u32(0, (uint32_t)prod) ^ (uint32_t)(prod >> 32);
+	n &= ~31;
+	
+	while(n) {
+		result = crc32c_multiply_sse42(result, RapidYenc::crc32c_power[ctz32(n)]);
+		n &= n-1;
+	}
+	return result;
+}
+#endif
+
+
+void RapidYenc::crc32c_sse42_set_funcs() {
+	_do_crc32c_incremental = &do_crc32c_incremental_sse42;
+	_crc32c_multiply = &crc32c_multiply_sse42;
+#if defined(__GNUC__) || defined(_MSC_VER)
+	_crc32c_shift = &crc32c_shift_sse42;
+#endif
+	_crc32c_isa = ISA_LEVEL_SSE42;
+}
+#else
+void RapidYenc::crc32c_sse42_set_funcs() {}
+#endif
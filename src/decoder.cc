@@ -29,7 +29,7 @@ static size_t do_decode_noend_scalar(const unsigned char* src, unsigned char* de
 				i++;
 				if(c == '\r') {
 					*state = YDEC_STATE_CR;
-					if(i >= 0) return 0;
+					if(i >= 0) return p - dest;
 				} else {
 					*state = YDEC_STATE_NONE;
 					break;
@@ -39,7 +39,7 @@ static size_t do_decode_noend_scalar(const unsigned char* src, unsigned char* de
 				if(es[i] != '\n') break;
 				i++;
 				*state = YDEC_STATE_CRLF;
-				if(i >= 0) return 0;
+				if(i >= 0) return p - dest;
 				// Else fall-thru
 			case YDEC_STATE_CRLF:
 				// skip past first dot
@@ -337,13 +337,39 @@ RapidYenc::YencDecoderEnd RapidYenc::do_decode_scalar(const unsigned char** src,
 	return YDEC_END_NONE;
 }
 
+// the scalar decoder has no alignment requirements or lookahead, so segments can be decoded one after the other
+template<bool isRaw>
+static size_t do_decode_iov_scalar(const RapidYenc::iovec_segment* segs, size_t numSegs, unsigned char* dest, RapidYenc::YencDecoderState* state) {
+	unsigned char* p = dest;
+	for(size_t s=0; s<numSegs; s++)
+		p += do_decode_noend_scalar<isRaw>((const unsigned char*)segs[s].base, p, segs[s].len, state);
+	return p - dest;
+}
+
+static RapidYenc::YencDecoderEnd do_decode_end_raw_ring_scalar(const unsigned char* srcA, size_t lenA, const unsigned char* srcB, size_t lenB, unsigned char** dest, size_t* consumed, RapidYenc::YencDecoderState* state) {
+	const unsigned char* src = srcA;
+	RapidYenc::YencDecoderEnd ended = do_decode_end_scalar<true>(&src, dest, lenA, state);
+	if(ended || !lenB) {
+		*consumed = src - srcA;
+		return ended;
+	}
+	src = srcB;
+	ended = do_decode_end_scalar<true>(&src, dest, lenB, state);
+	*consumed = lenA + (src - srcB);
+	return ended;
+}
+
 
 namespace RapidYenc {
 	YencDecoderEnd (*_do_decode)(const unsigned char**, unsigned char**, size_t, YencDecoderState*) = &do_decode_scalar<false, false>;
 	YencDecoderEnd (*_do_decode_raw)(const unsigned char**, unsigned char**, size_t, YencDecoderState*) = &do_decode_scalar<true, false>;
 	YencDecoderEnd (*_do_decode_end_raw)(const unsigned char**, unsigned char**, size_t, YencDecoderState*) = &do_decode_end_scalar<true>;
+	size_t (*_do_decode_iov)(const iovec_segment*, size_t, unsigned char*, YencDecoderState*) = &do_decode_iov_scalar<false>;
+	size_t (*_do_decode_raw_iov)(const iovec_segment*, size_t, unsigned char*, YencDecoderState*) = &do_decode_iov_scalar<true>;
+	YencDecoderEnd (*_do_decode_end_raw_ring)(const unsigned char*, size_t, const unsigned char*, size_t, unsigned char**, size_t*, YencDecoderState*) = &do_decode_end_raw_ring_scalar;
 	
 	int _decode_isa = ISA_GENERIC;
+	size_t _decode_width = 1;
 	
 	template YencDecoderEnd do_decode_scalar<true, true>(const unsigned char**, unsigned char**, size_t, YencDecoderState*);
 }
@@ -359,6 +385,10 @@ static inline void decoder_set_native_funcs() {
 	_do_decode = &do_decode_simd<false, false, sizeof(__m256i)*2, do_decode_avx2<false, false, ISA_NATIVE> >;
 	_do_decode_raw = &do_decode_simd<true, false, sizeof(__m256i)*2, do_decode_avx2<true, false, ISA_NATIVE> >;
 	_do_decode_end_raw = &do_decode_simd<true, true, sizeof(__m256i)*2, do_decode_avx2<true, true, ISA_NATIVE> >;
+	_do_decode_iov = &do_decode_iov_simd<false, sizeof(__m256i)*2, do_decode_avx2<false, false, ISA_NATIVE> >;
+	_do_decode_raw_iov = &do_decode_iov_simd<true, sizeof(__m256i)*2, do_decode_avx2<true, false, ISA_NATIVE> >;
+	_do_decode_end_raw_ring = &do_decode_end_raw_ring_simd<sizeof(__m256i)*2, do_decode_avx2<true, true, ISA_NATIVE> >;
+	_decode_width = sizeof(__m256i)*2;
 	_decode_isa = ISA_NATIVE;
 }
 # else
@@ -370,6 +400,10 @@ static inline void decoder_set_native_funcs() {
 	_do_decode = &do_decode_simd<false, false, sizeof(__m128i)*2, do_decode_sse<false, false, ISA_NATIVE> >;
 	_do_decode_raw = &do_decode_simd<true, false, sizeof(__m128i)*2, do_decode_sse<true, false, ISA_NATIVE> >;
 	_do_decode_end_raw = &do_decode_simd<true, true, sizeof(__m128i)*2, do_decode_sse<true, true, ISA_NATIVE> >;
+	_do_decode_iov = &do_decode_iov_simd<false, sizeof(__m128i)*2, do_decode_sse<false, false, ISA_NATIVE> >;
+	_do_decode_raw_iov = &do_decode_iov_simd<true, sizeof(__m128i)*2, do_decode_sse<true, false, ISA_NATIVE> >;
+	_do_decode_end_raw_ring = &do_decode_end_raw_ring_simd<sizeof(__m128i)*2, do_decode_sse<true, true, ISA_NATIVE> >;
+	_decode_width = sizeof(__m128i)*2;
 	_decode_isa = ISA_NATIVE;
 }
 # endif
@@ -406,7 +440,9 @@ void RapidYenc::decoder_init() {
 	decoder_set_native_funcs();
 # else
 	int use_isa = cpu_supports_isa();
-	if(use_isa >= ISA_LEVEL_VBMI2 && (decoder_has_avx10 || (use_isa & ISA_FEATURE_EVEX512)))
+	if(use_isa >= ISA_LEVEL_VBMI2 && (use_isa & ISA_FEATURE_FAST512))
+		decoder_set_vbmi2_512_funcs();
+	else if(use_isa >= ISA_LEVEL_VBMI2 && (decoder_has_avx10 || (use_isa & ISA_FEATURE_EVEX512)))
 		decoder_set_vbmi2_funcs();
 	else if(use_isa >= ISA_LEVEL_AVX2)
 		decoder_set_avx2_funcs();
@@ -419,6 +455,12 @@ void RapidYenc::decoder_init() {
 # endif
 #endif
 #ifdef PLATFORM_ARM
+# ifdef YENC_ENABLE_EXPERIMENTAL_KERNELS
+	// at 128-bit, SVE2 offers little over the NEON kernel, which has been tuned more
+	if(cpu_supports_sve2() && cpu_sve_length() > 16)
+		decoder_set_sve2_funcs();
+	else
+# endif
 	if(cpu_supports_neon())
 		decoder_set_neon_funcs();
 #endif
@@ -427,3 +469,42 @@ void RapidYenc::decoder_init() {
 		decoder_set_rvv_funcs();
 #endif
 }
+
+bool RapidYenc::decoder_set_kernel(int isa) {
+	if(isa == ISA_GENERIC) {
+		_do_decode = &do_decode_scalar<false, false>;
+		_do_decode_raw = &do_decode_scalar<true, false>;
+		_do_decode_end_raw = &do_decode_end_scalar<true>;
+		_do_decode_iov = &do_decode_iov_scalar<false>;
+		_do_decode_raw_iov = &do_decode_iov_scalar<true>;
+		_do_decode_end_raw_ring = &do_decode_end_raw_ring_scalar;
+		_decode_isa = ISA_GENERIC;
+		_decode_width = 1;
+		return true;
+	}
+#if defined(PLATFORM_X86) && !(defined(YENC_BUILD_NATIVE) && YENC_BUILD_NATIVE!=0)
+	int use_isa = cpu_supports_isa();
+	if(isa == (ISA_LEVEL_VBMI2 | ISA_FEATURE_EVEX512) && use_isa >= ISA_LEVEL_VBMI2 && (use_isa & ISA_FEATURE_EVEX512))
+		decoder_set_vbmi2_512_funcs();
+	else if(isa == ISA_LEVEL_VBMI2 && use_isa >= ISA_LEVEL_VBMI2 && (decoder_has_avx10 || (use_isa & ISA_FEATURE_EVEX512)))
+		decoder_set_vbmi2_funcs();
+	else if(isa == ISA_LEVEL_AVX2 && use_isa >= ISA_LEVEL_AVX2)
+		decoder_set_avx2_funcs();
+	else if(isa == ISA_LEVEL_AVX && use_isa >= ISA_LEVEL_AVX)
+		decoder_set_avx_funcs();
+	else if(isa == ISA_LEVEL_SSSE3 && use_isa >= ISA_LEVEL_SSSE3)
+		decoder_set_ssse3_funcs();
+	else if(isa == ISA_LEVEL_SSE2)
+		decoder_set_sse2_funcs();
+#elif defined(PLATFORM_ARM)
+# ifdef YENC_ENABLE_EXPERIMENTAL_KERNELS
+	if(isa == ISA_LEVEL_SVE2 && cpu_supports_sve2())
+		decoder_set_sve2_funcs();
+	else
+# endif
+	if(isa == ISA_LEVEL_NEON && cpu_supports_neon())
+		decoder_set_neon_funcs();
+#endif
+	// the init functions fall back to a lower level if the compiler didn't support the requested one
+	return _decode_isa == isa;
+}
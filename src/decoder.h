@@ -2,6 +2,7 @@
 #define __YENC_DECODER_H
 
 #include "hedley.h"
+#include "parallel.h"
 
 namespace RapidYenc {
 
@@ -31,6 +32,7 @@ extern YencDecoderEnd (*_do_decode)(const unsigned char**, unsigned char**, size
 extern YencDecoderEnd (*_do_decode_raw)(const unsigned char**, unsigned char**, size_t, YencDecoderState*);
 extern YencDecoderEnd (*_do_decode_end_raw)(const unsigned char**, unsigned char**, size_t, YencDecoderState*);
 extern int _decode_isa;
+extern size_t _decode_width; // block size of the selected kernel, which its aligned loads are based on
 
 static inline size_t decode(int isRaw, const void* src, void* dest, size_t len, YencDecoderState* state) {
 	unsigned char* ds = (unsigned char*)dest;
@@ -42,11 +44,99 @@ static inline YencDecoderEnd decode_end(const void** src, void** dest, size_t le
 	return _do_decode_end_raw((const unsigned char**)src, (unsigned char**)dest, len, state);
 }
 
+extern size_t (*_do_decode_iov)(const iovec_segment*, size_t, unsigned char*, YencDecoderState*);
+extern size_t (*_do_decode_raw_iov)(const iovec_segment*, size_t, unsigned char*, YencDecoderState*);
+static inline size_t decode_iov(int isRaw, const iovec_segment* segs, size_t numSegs, void* dest, YencDecoderState* state) {
+	return (*(isRaw ? _do_decode_raw_iov : _do_decode_iov))(segs, numSegs, (unsigned char*)dest, state);
+}
+
+extern YencDecoderEnd (*_do_decode_end_raw_ring)(const unsigned char*, size_t, const unsigned char*, size_t, unsigned char**, size_t*, YencDecoderState*);
+// like decode_end, but decodes `tail - head` bytes from a ring buffer of `mask+1` bytes, where `head` and `tail` are free-running positions
+static inline YencDecoderEnd decode_end_ring(const void* ring, size_t mask, size_t head, size_t tail, void** dest, size_t* consumed, YencDecoderState* state) {
+	const unsigned char* base = (const unsigned char*)ring;
+	size_t len = tail - head;
+	if(len > mask+1) len = mask+1;
+	size_t start = head & mask;
+	size_t lenA = mask+1 - start;
+	if(lenA > len) lenA = len;
+	return _do_decode_end_raw_ring(base + start, lenA, base, len - lenA, (unsigned char**)dest, consumed, state);
+}
+
+size_t decode_parallel(int isRaw, const void* src, void* dest, size_t len, YencDecoderState* state, size_t numChunks, task_runner runner, void* pool);
+
+// result of parsing and decoding a whole yEnc article
+typedef enum {
+	YART_OK,
+	YART_NO_BEGIN,   // no =ybegin line found
+	YART_BAD_HEADER, // =ybegin or =ypart line is missing required fields, or has an invalid value
+	YART_TRUNCATED,  // input, or the NNTP article, ended before =yend
+	YART_BAD_TRAILER // control line other than =yend found in the body, or =yend is missing required fields or has an invalid value
+} YencArticleResult;
+
+#define YART_FLAG_PART 1   // =ypart line present
+#define YART_FLAG_END 2    // =yend line present
+#define YART_FLAG_PCRC32 4 // pcrc32= present in =yend
+#define YART_FLAG_CRC32 8  // crc32= present in =yend
+
+// layout must match RapidYencArticle
+struct yenc_article {
+	uint64_t size;
+	uint64_t partBegin;
+	uint64_t partEnd;
+	uint64_t endSize;
+	const char* name;
+	size_t nameLength;
+	size_t dataOffset;
+	size_t dataLength;
+	size_t srcConsumed;
+	uint32_t pcrc32;
+	uint32_t crc32;
+	int line;
+	int part;
+	int total;
+	int endPart;
+	int flags;
+};
+YencArticleResult decode_article(const void* src, size_t len, void* dest, yenc_article* article);
+// the two halves of decode_article, for callers which decode the body themselves
+// the header is parsed up to the start of the body (`article->dataOffset`); the trailer is parsed given where the body decode stopped, and how
+YencArticleResult decode_article_header(const void* src, size_t len, yenc_article* article);
+YencArticleResult decode_article_trailer(const void* src, size_t len, const void* bodyEnd, YencDecoderEnd ended, yenc_article* article);
+
+// splitting of pipelined NNTP responses; layouts must match RapidYencNntpReader and RapidYencNntpResponse
+#define NNTP_YENC_BEGIN 1 // =ybegin seen
+#define NNTP_YENC_END 2   // =yend seen
+struct nntp_reader {
+	int phase;
+	int status;
+	int statusLength;
+	int yenc;
+	YencDecoderState state;
+	int controlLength;
+	char control[4];
+};
+struct nntp_response {
+	int status;
+	int complete;
+	int yenc;
+	YencDecoderState state;
+	size_t srcOffset;
+	size_t srcLength;
+	size_t bodyOffset;
+	size_t decodedLength;
+};
+void nntp_reader_init(nntp_reader* reader);
+size_t nntp_split(nntp_reader* reader, const void* src, size_t len, void* dest, nntp_response* responses, size_t maxResponses, size_t* consumed);
+
 void decoder_init();
+bool decoder_set_kernel(int isa);
 
 static inline int decode_isa_level() {
 	return _decode_isa;
 }
+static inline size_t decode_width() {
+	return _decode_width;
+}
 
 
 } // namespace
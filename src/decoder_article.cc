@@ -0,0 +1,184 @@
+#include "common.h"
+#include "decoder.h"
+#include <string.h>
+#include <limits.h>
+
+// header lines are located with memchr, which is vectorised in most C libraries; the body is decoded with the regular kernels, which also find the =yend line (or any other =y line) for us
+// control lines are short, so scanning them for keywords byte-wise is cheap compared to the body
+
+// returns the end of the line starting at `p` (i.e. the position of its '\n', or `end` if there's none), with any trailing '\r' excluded via `lineEnd`
+static const char* article_line_end(const char* p, const char* end, const char** lineEnd) {
+	const char* lf = (const char*)memchr(p, '\n', end - p);
+	if(!lf) lf = end;
+	*lineEnd = (lf > p && lf[-1] == '\r') ? lf-1 : lf;
+	return lf;
+}
+
+// finds the value of keyword `key` (which includes the '=') in the line [p, end); keywords must be preceded by a space
+static const char* article_find_key(const char* p, const char* end, const char* key) {
+	size_t keyLen = strlen(key);
+	while(end - p > (ptrdiff_t)keyLen) {
+		const char* match = (const char*)memchr(p+1, key[0], end - p - keyLen);
+		if(!match) break;
+		if(match[-1] == ' ' && memcmp(match, key, keyLen) == 0)
+			return match + keyLen;
+		p = match;
+	}
+	return NULL;
+}
+
+// keyword parsers return one of these; the value is only written if the keyword is present with a valid value
+enum {
+	ARTICLE_KEY_INVALID = -1, // present, but the value is empty or out of range
+	ARTICLE_KEY_MISSING = 0,
+	ARTICLE_KEY_OK = 1
+};
+
+static int article_parse_dec(const char* p, const char* end, const char* key, uint64_t* value) {
+	p = article_find_key(p, end, key);
+	if(!p) return ARTICLE_KEY_MISSING;
+	if(p == end || *p < '0' || *p > '9') return ARTICLE_KEY_INVALID;
+	uint64_t result = 0;
+	for(; p < end && *p >= '0' && *p <= '9'; p++) {
+		unsigned digit = *p - '0';
+		if(result > (~(uint64_t)0 - digit) / 10) return ARTICLE_KEY_INVALID;
+		result = result*10 + digit;
+	}
+	*value = result;
+	return ARTICLE_KEY_OK;
+}
+static int article_parse_int(const char* p, const char* end, const char* key, int* value) {
+	uint64_t result;
+	int found = article_parse_dec(p, end, key, &result);
+	if(found != ARTICLE_KEY_OK) return found;
+	if(result > INT_MAX) return ARTICLE_KEY_INVALID;
+	*value = (int)result;
+	return ARTICLE_KEY_OK;
+}
+static int article_parse_hex(const char* p, const char* end, const char* key, uint32_t* value) {
+	p = article_find_key(p, end, key);
+	if(!p) return ARTICLE_KEY_MISSING;
+	uint32_t result = 0;
+	const char* start = p;
+	for(; p < end; p++) {
+		unsigned char c = *p;
+		if(c >= '0' && c <= '9') c -= '0';
+		else if((c|0x20) >= 'a' && (c|0x20) <= 'f') c = (c|0x20) - 'a' + 10;
+		else break;
+		if(p - start >= 8) return ARTICLE_KEY_INVALID; // more digits than fit in a CRC32
+		result = (result << 4) | c;
+	}
+	if(p == start) return ARTICLE_KEY_INVALID;
+	*value = result;
+	return ARTICLE_KEY_OK;
+}
+
+static bool article_line_is(const char* p, const char* end, const char* keyword) {
+	size_t len = strlen(keyword);
+	return (size_t)(end - p) > len && memcmp(p, keyword, len) == 0 && p[len] == ' ';
+}
+
+RapidYenc::YencArticleResult RapidYenc::decode_article_header(const void* src, size_t len, yenc_article* article) {
+	const char* start = (const char*)src;
+	const char* end = start + len;
+	memset(article, 0, sizeof(yenc_article));
+	
+	// find the =ybegin line; anything before it is skipped
+	const char* p = start;
+	while(1) {
+		p = (const char*)memchr(p, '=', end - p);
+		if(!p) {
+			article->srcConsumed = len;
+			return YART_NO_BEGIN;
+		}
+		if((p == start || p[-1] == '\n') && article_line_is(p, end, "=ybegin"))
+			break;
+		p++;
+	}
+	
+	const char* lineEnd;
+	const char* lf = article_line_end(p, end, &lineEnd);
+	if(lf == end) {
+		article->srcConsumed = len;
+		return YART_TRUNCATED;
+	}
+	article->srcConsumed = lf+1 - start;
+	// name= is always last, and can contain anything, so only look for other keywords before it
+	const char* name = article_find_key(p, lineEnd, "name=");
+	if(!name || article_parse_dec(p, name, "size=", &article->size) != ARTICLE_KEY_OK)
+		return YART_BAD_HEADER;
+	article->name = name;
+	article->nameLength = lineEnd - name;
+	if(article_parse_int(p, name, "line=", &article->line) == ARTICLE_KEY_INVALID
+	|| article_parse_int(p, name, "total=", &article->total) == ARTICLE_KEY_INVALID)
+		return YART_BAD_HEADER;
+	int hasPart = article_parse_int(p, name, "part=", &article->part);
+	if(hasPart == ARTICLE_KEY_INVALID)
+		return YART_BAD_HEADER;
+	if(hasPart) {
+		// multi-part articles need a =ypart line, giving the position of this part in the file
+		p = lf+1;
+		lf = article_line_end(p, end, &lineEnd);
+		if(lf == end) {
+			article->srcConsumed = len;
+			return YART_TRUNCATED;
+		}
+		article->srcConsumed = lf+1 - start;
+		if(!article_line_is(p, lineEnd, "=ypart")
+		|| article_parse_dec(p, lineEnd, "begin=", &article->partBegin) != ARTICLE_KEY_OK
+		|| article_parse_dec(p, lineEnd, "end=", &article->partEnd) != ARTICLE_KEY_OK)
+			return YART_BAD_HEADER;
+		article->flags |= YART_FLAG_PART;
+	}
+	
+	article->dataOffset = lf+1 - start;
+	return YART_OK;
+}
+
+RapidYenc::YencArticleResult RapidYenc::decode_article_trailer(const void* src, size_t len, const void* bodyEnd, YencDecoderEnd ended, yenc_article* article) {
+	const char* start = (const char*)src;
+	const char* end = start + len;
+	const char* p = (const char*)bodyEnd;
+	if(ended != YDEC_END_CONTROL) {
+		article->srcConsumed = p - start;
+		return YART_TRUNCATED;
+	}
+	// the decoder stopped after the "=y" of a control line
+	p -= 2;
+	const char* lineEnd;
+	const char* lf = article_line_end(p, end, &lineEnd);
+	if(lf == end) {
+		// the line isn't terminated, so the input may have been cut off part way through it, leaving keywords missing or values incomplete
+		article->srcConsumed = len;
+		return YART_TRUNCATED;
+	}
+	article->srcConsumed = lf+1 - start;
+	if(!article_line_is(p, lineEnd, "=yend"))
+		return YART_BAD_TRAILER;
+	article->flags |= YART_FLAG_END;
+	if(article_parse_dec(p, lineEnd, "size=", &article->endSize) != ARTICLE_KEY_OK
+	|| article_parse_int(p, lineEnd, "part=", &article->endPart) == ARTICLE_KEY_INVALID)
+		return YART_BAD_TRAILER;
+	int hasPcrc = article_parse_hex(p, lineEnd, "pcrc32=", &article->pcrc32);
+	int hasCrc = article_parse_hex(p, lineEnd, "crc32=", &article->crc32);
+	if(hasPcrc == ARTICLE_KEY_INVALID || hasCrc == ARTICLE_KEY_INVALID)
+		return YART_BAD_TRAILER;
+	if(hasPcrc)
+		article->flags |= YART_FLAG_PCRC32;
+	if(hasCrc)
+		article->flags |= YART_FLAG_CRC32;
+	return YART_OK;
+}
+
+RapidYenc::YencArticleResult RapidYenc::decode_article(const void* src, size_t len, void* dest, yenc_article* article) {
+	YencArticleResult result = decode_article_header(src, len, article);
+	if(result != YART_OK) return result;
+	
+	// decode the body to the same offset in `dest`, so that in-situ decoding doesn't overwrite the header (which `name` points into)
+	const void* in = (const char*)src + article->dataOffset;
+	void* out = (char*)dest + article->dataOffset;
+	YencDecoderState state = YDEC_STATE_CRLF;
+	YencDecoderEnd ended = decode_end(&in, &out, len - article->dataOffset, &state);
+	article->dataLength = (char*)out - ((char*)dest + article->dataOffset);
+	return decode_article_trailer(src, len, in, ended, article);
+}
@@ -4,11 +4,17 @@
 #if defined(__AVX2__) && !defined(YENC_DISABLE_AVX256)
 #include "decoder_avx2_base.h"
 void RapidYenc::decoder_set_avx2_funcs() {
-	ALIGN_ALLOC(lookups, sizeof(*lookups), 16);
-	decoder_init_lut(lookups->compact);
+	if(!lookups) { // may already be set up, if the kernel was re-selected
+		ALIGN_ALLOC(lookups, sizeof(*lookups), 16);
+		decoder_init_lut(lookups->compact);
+	}
 	RapidYenc::_do_decode = &do_decode_simd<false, false, sizeof(__m256i)*2, do_decode_avx2<false, false, ISA_LEVEL_AVX2> >;
 	RapidYenc::_do_decode_raw = &do_decode_simd<true, false, sizeof(__m256i)*2, do_decode_avx2<true, false, ISA_LEVEL_AVX2> >;
 	RapidYenc::_do_decode_end_raw = &do_decode_simd<true, true, sizeof(__m256i)*2, do_decode_avx2<true, true, ISA_LEVEL_AVX2> >;
+	RapidYenc::_do_decode_iov = &do_decode_iov_simd<false, sizeof(__m256i)*2, do_decode_avx2<false, false, ISA_LEVEL_AVX2> >;
+	RapidYenc::_do_decode_raw_iov = &do_decode_iov_simd<true, sizeof(__m256i)*2, do_decode_avx2<true, false, ISA_LEVEL_AVX2> >;
+	RapidYenc::_do_decode_end_raw_ring = &do_decode_end_raw_ring_simd<sizeof(__m256i)*2, do_decode_avx2<true, true, ISA_LEVEL_AVX2> >;
+	RapidYenc::_decode_width = sizeof(__m256i)*2;
 	RapidYenc::_decode_isa = ISA_LEVEL_AVX2;
 }
 #else
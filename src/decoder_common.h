@@ -6,8 +6,10 @@ namespace RapidYenc {
 	void decoder_set_avx_funcs();
 	void decoder_set_avx2_funcs();
 	void decoder_set_vbmi2_funcs();
+	void decoder_set_vbmi2_512_funcs();
 	extern const bool decoder_has_avx10;
 	void decoder_set_neon_funcs();
+	void decoder_set_sve2_funcs();
 	void decoder_set_rvv_funcs();
 	
 	template<bool isRaw, bool searchEnd>
@@ -23,23 +25,11 @@ namespace RapidYenc {
 
 
 
+// runs the SIMD kernel over an aligned `*src`, leaving the last few bytes (fewer than `width` plus the kernel's lookahead) for the scalar decoder; `len` is updated to the number of bytes left
 template<bool isRaw, bool searchEnd, void(&kernel)(const uint8_t*, long&, unsigned char*&, unsigned char&, uint16_t&)>
-static inline RapidYenc::YencDecoderEnd _do_decode_simd(size_t width, const unsigned char** src, unsigned char** dest, size_t len, RapidYenc::YencDecoderState* state) {
+static inline RapidYenc::YencDecoderEnd _do_decode_simd_aligned(size_t width, const unsigned char** src, unsigned char** dest, size_t& len, RapidYenc::YencDecoderState* pState) {
 	using namespace RapidYenc;
 	
-	if(len <= width*2) return do_decode_scalar<isRaw, searchEnd>(src, dest, len, state);
-	
-	YencDecoderState tState = YDEC_STATE_CRLF;
-	YencDecoderState* pState = state ? state : &tState;
-	if((uintptr_t)(*src) & ((width-1))) {
-		// find source memory alignment
-		unsigned char* aSrc = (unsigned char*)(((uintptr_t)(*src) + (width-1)) & ~(width-1));
-		int amount = (int)(aSrc - *src);
-		len -= amount;
-		YencDecoderEnd ended = do_decode_scalar<isRaw, searchEnd>(src, dest, amount, pState);
-		if(ended) return ended;
-	}
-	
 	size_t lenBuffer = width -1;
 	if(searchEnd) lenBuffer += 3 + (isRaw?1:0);
 	else if(isRaw) lenBuffer += 2;
@@ -135,6 +125,28 @@ static inline RapidYenc::YencDecoderEnd _do_decode_simd(size_t width, const unsi
 		len -= dLen;
 		*dest = p;
 	}
+	return YDEC_END_NONE;
+}
+
+template<bool isRaw, bool searchEnd, void(&kernel)(const uint8_t*, long&, unsigned char*&, unsigned char&, uint16_t&)>
+static inline RapidYenc::YencDecoderEnd _do_decode_simd(size_t width, const unsigned char** src, unsigned char** dest, size_t len, RapidYenc::YencDecoderState* state) {
+	using namespace RapidYenc;
+	
+	if(len <= width*2) return do_decode_scalar<isRaw, searchEnd>(src, dest, len, state);
+	
+	YencDecoderState tState = YDEC_STATE_CRLF;
+	YencDecoderState* pState = state ? state : &tState;
+	if((uintptr_t)(*src) & ((width-1))) {
+		// find source memory alignment
+		unsigned char* aSrc = (unsigned char*)(((uintptr_t)(*src) + (width-1)) & ~(width-1));
+		int amount = (int)(aSrc - *src);
+		len -= amount;
+		YencDecoderEnd ended = do_decode_scalar<isRaw, searchEnd>(src, dest, amount, pState);
+		if(ended) return ended;
+	}
+	
+	YencDecoderEnd ended = _do_decode_simd_aligned<isRaw, searchEnd, kernel>(width, src, dest, len, pState);
+	if(ended) return ended;
 	
 	// end alignment
 	if(len)
@@ -165,6 +177,156 @@ static RapidYenc::YencDecoderEnd do_decode_simd(const unsigned char** src, unsig
 }
 
 
+// for decoding scattered input: the undecoded end of a segment is copied into a small aligned buffer along with the start of the next, so that the SIMD kernel can continue across the seam, instead of leaving it to the scalar decoder
+// short segments are gathered into the buffer whole, as the scalar decoder would otherwise handle a large part of them
+#define DECODE_IOV_STITCH_SIZE 4096
+#define DECODE_IOV_MIN_DIRECT 1024 // segments at least this long are decoded in place
+
+template<bool isRaw, void(&kernel)(const uint8_t*, long&, unsigned char*&, unsigned char&, uint16_t&)>
+static size_t _do_decode_iov_simd(size_t width, const RapidYenc::iovec_segment* segs, size_t numSegs, unsigned char* dest, RapidYenc::YencDecoderState* state) {
+	using namespace RapidYenc;
+	unsigned char* p = dest;
+	if(width*4 > DECODE_IOV_STITCH_SIZE/2) {
+		// vectors are too wide for the stitch buffer to be of much use, so just decode each segment separately
+		for(size_t s=0; s<numSegs; s++) {
+			const unsigned char* src = (const unsigned char*)segs[s].base;
+			_do_decode_simd<isRaw, false, kernel>(width, &src, &p, segs[s].len, state);
+		}
+		return p - dest;
+	}
+	
+	uint8_t stitchMem[DECODE_IOV_STITCH_SIZE];
+	uint8_t* stitch = (uint8_t*)(((uintptr_t)stitchMem + (width-1)) & ~(width-1));
+	size_t stitchSize = DECODE_IOV_STITCH_SIZE - (stitch - stitchMem);
+	size_t carry = 0; // number of bytes at the start of `stitch` which haven't been decoded yet
+	for(size_t s=0; s<numSegs; s++) {
+		const unsigned char* src = (const unsigned char*)segs[s].base;
+		size_t len = segs[s].len;
+		
+		while(len && (carry || len < DECODE_IOV_MIN_DIRECT)) {
+			size_t take = stitchSize - carry;
+			// if the rest of the segment can be decoded in place, only take enough to get past the seam
+			if(len >= DECODE_IOV_MIN_DIRECT && take > carry + width*2) take = carry + width*2;
+			if(take > len) take = len;
+			memcpy(stitch + carry, src, take);
+			src += take;
+			len -= take;
+			carry += take;
+			if(!len && carry < stitchSize) break; // gather more from the next segment
+			
+			const unsigned char* in = stitch;
+			size_t remaining = carry;
+			_do_decode_simd_aligned<isRaw, false, kernel>(width, &in, &p, remaining, state);
+			if(remaining <= take) {
+				// kernel got past the seam, so continue from within the segment
+				src -= remaining;
+				len += remaining;
+				carry = 0;
+			} else {
+				memmove(stitch, stitch + carry - remaining, remaining);
+				carry = remaining;
+			}
+		}
+		if(!len) continue;
+		
+		// decode in place, carrying the end over to the next seam
+		size_t amount = (size_t)(-(intptr_t)src) & (width-1);
+		do_decode_scalar<isRaw, false>(&src, &p, amount, state);
+		len -= amount;
+		_do_decode_simd_aligned<isRaw, false, kernel>(width, &src, &p, len, state);
+		memcpy(stitch, src, len);
+		carry = len;
+	}
+	
+	const unsigned char* in = stitch;
+	_do_decode_simd<isRaw, false, kernel>(width, &in, &p, carry, state);
+	return p - dest;
+}
+template<bool isRaw, size_t width, void(&kernel)(const uint8_t*, long&, unsigned char*&, unsigned char&, uint16_t&)>
+static size_t do_decode_iov_simd(const RapidYenc::iovec_segment* segs, size_t numSegs, unsigned char* dest, RapidYenc::YencDecoderState* state) {
+	return _do_decode_iov_simd<isRaw, kernel>(width, segs, numSegs, dest, state);
+}
+template<bool isRaw, size_t(&getWidth)(), void(&kernel)(const uint8_t*, long&, unsigned char*&, unsigned char&, uint16_t&)>
+static size_t do_decode_iov_simd(const RapidYenc::iovec_segment* segs, size_t numSegs, unsigned char* dest, RapidYenc::YencDecoderState* state) {
+	return _do_decode_iov_simd<isRaw, kernel>(getWidth(), segs, numSegs, dest, state);
+}
+
+
+// decodes data which wraps around the end of a ring buffer, i.e. `lenA` bytes at `srcA` followed by `lenB` bytes at the start of the ring, `srcB`
+// the seam is stitched as in _do_decode_iov_simd; if the ring is aligned to `width`, the first part ends on an aligned boundary, so the amount left undecoded before the seam is a multiple of `width`, which means that decoding resumes at an aligned position in the second part
+template<void(&kernel)(const uint8_t*, long&, unsigned char*&, unsigned char&, uint16_t&)>
+static RapidYenc::YencDecoderEnd _do_decode_end_raw_ring_simd(size_t width, const unsigned char* srcA, size_t lenA, const unsigned char* srcB, size_t lenB, unsigned char** dest, size_t* consumed, RapidYenc::YencDecoderState* state) {
+	using namespace RapidYenc;
+	const unsigned char* src = srcA;
+	YencDecoderEnd ended;
+	if(!lenB || lenA <= width*2 || width*4 > DECODE_IOV_STITCH_SIZE/2) {
+		// no wrap, or not worth stitching
+		ended = _do_decode_simd<true, true, kernel>(width, &src, dest, lenA, state);
+		if(ended || !lenB) {
+			*consumed = src - srcA;
+			return ended;
+		}
+		src = srcB;
+		ended = _do_decode_simd<true, true, kernel>(width, &src, dest, lenB, state);
+		*consumed = lenA + (src - srcB);
+		return ended;
+	}
+	
+	// decode the first part up to its last few bytes
+	size_t len = lenA;
+	size_t amount = (size_t)(-(intptr_t)src) & (width-1);
+	len -= amount;
+	ended = do_decode_scalar<true, true>(&src, dest, amount, state);
+	if(!ended) ended = _do_decode_simd_aligned<true, true, kernel>(width, &src, dest, len, state);
+	if(!ended && len > width*2) {
+		// the kernel stops early if it sees what could be an end sequence, leaving the rest to the scalar decoder
+		ended = do_decode_scalar<true, true>(&src, dest, len, state);
+		if(!ended) {
+			src = srcB;
+			ended = _do_decode_simd<true, true, kernel>(width, &src, dest, lenB, state);
+			*consumed = lenA + (src - srcB);
+			return ended;
+		}
+	}
+	if(ended) {
+		*consumed = src - srcA;
+		return ended;
+	}
+	
+	// run the kernel over the seam
+	uint8_t stitchMem[DECODE_IOV_STITCH_SIZE];
+	uint8_t* stitch = (uint8_t*)(((uintptr_t)stitchMem + (width-1)) & ~(width-1));
+	size_t carry = len;
+	size_t take = lenB < width*3 ? lenB : width*3; // enough for the kernel to get past the seam, as what it normally leaves behind is shorter than this
+	memcpy(stitch, src, carry);
+	memcpy(stitch + carry, srcB, take);
+	const unsigned char* in = stitch;
+	size_t remaining = carry + take;
+	ended = _do_decode_simd_aligned<true, true, kernel>(width, &in, dest, remaining, state);
+	if(!ended && remaining > take) // kernel stopped short of the seam
+		ended = do_decode_scalar<true, true>(&in, dest, remaining, state);
+	if(ended) {
+		*consumed = lenA - carry + (in - stitch);
+		return ended;
+	}
+	
+	// continue from within the second part
+	if(remaining > take) remaining = 0;
+	src = srcB + (take - remaining);
+	ended = _do_decode_simd<true, true, kernel>(width, &src, dest, lenB - (take - remaining), state);
+	*consumed = lenA + (src - srcB);
+	return ended;
+}
+template<size_t width, void(&kernel)(const uint8_t*, long&, unsigned char*&, unsigned char&, uint16_t&)>
+static RapidYenc::YencDecoderEnd do_decode_end_raw_ring_simd(const unsigned char* srcA, size_t lenA, const unsigned char* srcB, size_t lenB, unsigned char** dest, size_t* consumed, RapidYenc::YencDecoderState* state) {
+	return _do_decode_end_raw_ring_simd<kernel>(width, srcA, lenA, srcB, lenB, dest, consumed, state);
+}
+template<size_t(&getWidth)(), void(&kernel)(const uint8_t*, long&, unsigned char*&, unsigned char&, uint16_t&)>
+static RapidYenc::YencDecoderEnd do_decode_end_raw_ring_simd(const unsigned char* srcA, size_t lenA, const unsigned char* srcB, size_t lenB, unsigned char** dest, size_t* consumed, RapidYenc::YencDecoderState* state) {
+	return _do_decode_end_raw_ring_simd<kernel>(getWidth(), srcA, lenA, srcB, lenB, dest, consumed, state);
+}
+
+
 #if defined(PLATFORM_X86) || defined(PLATFORM_ARM)
 namespace RapidYenc {
 	void decoder_init_lut(void* compactLUT);
@@ -455,6 +455,10 @@ void RapidYenc::decoder_set_neon_funcs() {
 	_do_decode = &do_decode_simd<false, false, sizeof(uint8x16_t)*2, do_decode_neon<false, false> >;
 	_do_decode_raw = &do_decode_simd<true, false, sizeof(uint8x16_t)*2, do_decode_neon<true, false> >;
 	_do_decode_end_raw = &do_decode_simd<true, true, sizeof(uint8x16_t)*2, do_decode_neon<true, true> >;
+	_do_decode_iov = &do_decode_iov_simd<false, sizeof(uint8x16_t)*2, do_decode_neon<false, false> >;
+	_do_decode_raw_iov = &do_decode_iov_simd<true, sizeof(uint8x16_t)*2, do_decode_neon<true, false> >;
+	_do_decode_end_raw_ring = &do_decode_end_raw_ring_simd<sizeof(uint8x16_t)*2, do_decode_neon<true, true> >;
+	_decode_width = sizeof(uint8x16_t)*2;
 	_decode_isa = ISA_LEVEL_NEON;
 }
 #else
@@ -0,0 +1,142 @@
+#include "common.h"
+#include "decoder.h"
+#include <string.h>
+
+// splits a stream of pipelined NNTP responses, decoding the yEnc data in each
+// bodies are handled by the regular decoder, whose end detection stops at both the \r\n.\r\n terminator and =y control lines; the latter are skipped over, only noting whether it's a =ybegin or =yend
+
+enum {
+	NNTP_PHASE_STATUS, // in the status line
+	NNTP_PHASE_BODY, // in the body of a multi-line response
+	NNTP_PHASE_CONTROL, // in a =y line, after the "=y"
+	NNTP_PHASE_CONTROL_LINE // in a =y line, after it's been identified
+};
+
+// RFC 3977 responses which are followed by a multi-line data block
+static bool nntp_is_multiline(int status) {
+	switch(status) {
+		case 100: case 101: case 215: case 220: case 221: case 222: case 224: case 225: case 230: case 231:
+			return true;
+	}
+	return false;
+}
+
+void RapidYenc::nntp_reader_init(nntp_reader* reader) {
+	memset(reader, 0, sizeof(nntp_reader));
+	reader->phase = NNTP_PHASE_STATUS;
+	reader->state = YDEC_STATE_CRLF;
+}
+
+size_t RapidYenc::nntp_split(nntp_reader* reader, const void* src, size_t len, void* dest, nntp_response* responses, size_t maxResponses, size_t* consumed) {
+	const unsigned char* start = (const unsigned char*)src;
+	const unsigned char* end = start + len;
+	const unsigned char* p = start;
+	const unsigned char* responseStart = start;
+	nntp_response* resp = NULL;
+	size_t count = 0;
+	*consumed = 0;
+	if(!maxResponses) return 0;
+	
+	if(reader->phase != NNTP_PHASE_STATUS) {
+		// continuing the body of a response from the previous buffer
+		resp = responses + count++;
+		memset(resp, 0, sizeof(nntp_response));
+		resp->status = reader->status;
+	}
+	
+	while(p < end) {
+		if(reader->phase == NNTP_PHASE_STATUS) {
+			// only start a new response if there's space to describe it; a status line continued from the previous buffer has already been started
+			if(reader->statusLength == 0) {
+				if(count == maxResponses) break;
+				responseStart = p;
+			}
+			// the status code is the first three characters
+			while(p < end && reader->statusLength < 3 && *p != '\n') {
+				if(*p >= '0' && *p <= '9' && reader->status >= 0)
+					reader->status = reader->status*10 + (*p - '0');
+				else
+					reader->status = -1;
+				reader->statusLength++;
+				p++;
+			}
+			const unsigned char* lf = (const unsigned char*)memchr(p, '\n', end - p);
+			if(!lf) {
+				p = end;
+				break;
+			}
+			p = lf+1;
+			if(reader->statusLength < 3) reader->status = -1;
+			
+			resp = responses + count++;
+			memset(resp, 0, sizeof(nntp_response));
+			resp->status = reader->status;
+			resp->srcOffset = responseStart - start;
+			resp->bodyOffset = p - start;
+			if(nntp_is_multiline(reader->status)) {
+				reader->phase = NNTP_PHASE_BODY;
+				reader->state = YDEC_STATE_CRLF;
+				reader->yenc = 0;
+				continue;
+			}
+			// single line response, e.g. 430 (no such article)
+			resp->complete = 1;
+		}
+		else if(reader->phase == NNTP_PHASE_BODY) {
+			// the output is kept at the same offset as the body, and can't overtake the input, so in-situ decoding is possible
+			unsigned char* outStart = (unsigned char*)dest + resp->bodyOffset + resp->decodedLength;
+			void* out = outStart;
+			const void* in = p;
+			YencDecoderEnd ended = decode_end(&in, &out, end - p, &reader->state);
+			p = (const unsigned char*)in;
+			// only count data between =ybegin and =yend; anything else is overwritten by whatever comes next
+			if((reader->yenc & (NNTP_YENC_BEGIN | NNTP_YENC_END)) == NNTP_YENC_BEGIN)
+				resp->decodedLength += (unsigned char*)out - outStart;
+			if(ended == YDEC_END_CONTROL) {
+				reader->phase = NNTP_PHASE_CONTROL;
+				reader->controlLength = 0;
+				continue;
+			}
+			if(ended == YDEC_END_NONE) break;
+			resp->complete = 1;
+		}
+		else {
+			if(reader->phase == NNTP_PHASE_CONTROL) {
+				// identify the line from the characters after "=y"
+				while(p < end && reader->controlLength < 3 && *p != '\n')
+					reader->control[reader->controlLength++] = *p++;
+				if(p == end) break;
+				if(reader->controlLength == 3 && memcmp(reader->control, "beg", 3) == 0)
+					reader->yenc |= NNTP_YENC_BEGIN;
+				else if(reader->controlLength == 3 && memcmp(reader->control, "end", 3) == 0)
+					reader->yenc |= NNTP_YENC_END;
+				reader->phase = NNTP_PHASE_CONTROL_LINE;
+			}
+			const unsigned char* lf = (const unsigned char*)memchr(p, '\n', end - p);
+			if(!lf) {
+				p = end;
+				break;
+			}
+			p = lf+1;
+			reader->phase = NNTP_PHASE_BODY;
+			reader->state = YDEC_STATE_CRLF;
+			continue;
+		}
+		
+		// response complete
+		resp->srcLength = p - (start + resp->srcOffset);
+		resp->state = reader->state;
+		resp->yenc = reader->yenc;
+		resp = NULL;
+		nntp_reader_init(reader);
+	}
+	
+	if(resp) {
+		// response continues into the next buffer
+		resp->srcLength = p - (start + resp->srcOffset);
+		resp->state = reader->state;
+		resp->yenc = reader->yenc;
+	}
+	*consumed = p - start;
+	return count;
+}
@@ -0,0 +1,81 @@
+#include "common.h"
+#include "decoder.h"
+#include "parallel.h"
+#include <string.h>
+
+namespace RapidYenc {
+	struct decode_chunk {
+		size_t offset;
+		size_t len;
+		size_t outLen;
+		YencDecoderState state;
+	};
+	struct decode_parallel_job {
+		int isRaw;
+		const unsigned char* src;
+		unsigned char* dest;
+		decode_chunk* chunks;
+	};
+}
+
+static void decode_parallel_task(void* data, size_t index) {
+	RapidYenc::decode_parallel_job* job = (RapidYenc::decode_parallel_job*)data;
+	RapidYenc::decode_chunk& chunk = job->chunks[index];
+	// output can never be longer than the input, so decoding to the same offset as the source won't overlap with any other chunk's output
+	chunk.outLen = RapidYenc::decode(job->isRaw, job->src + chunk.offset, job->dest + chunk.offset, chunk.len, &chunk.state);
+}
+
+// find the position after the first \r\n at or after `pos`, which isn't preceded by '='
+// the decoder state here is always known: neither the \r nor the \n can be escaped, so, in raw mode, the state is YDEC_STATE_CRLF, whilst in non-raw mode, the only thing that matters is that it isn't YDEC_STATE_EQ
+// (an escaped \r is invalid yEnc, and how it's handled differs slightly depending on where the decoder's SIMD blocks fall, so these are avoided as split points)
+static size_t decode_find_boundary(const unsigned char* src, size_t pos, size_t len) {
+	if(pos < 2) pos = 2;
+	while(pos < len) {
+		const unsigned char* lf = (const unsigned char*)memchr(src + pos, '\n', len - pos);
+		if(!lf) break;
+		pos = lf - src + 1;
+		if(lf[-1] == '\r' && lf[-2] != '=') return pos;
+	}
+	return len;
+}
+
+size_t RapidYenc::decode_parallel(int isRaw, const void* src, void* dest, size_t len, YencDecoderState* state, size_t numChunks, task_runner runner, void* pool) {
+	if(numChunks < 2) numChunks = 1;
+	size_t chunkSize = len / numChunks;
+	if(chunkSize < PARALLEL_MIN_CHUNK) chunkSize = PARALLEL_MIN_CHUNK;
+	numChunks = (len + chunkSize-1) / chunkSize;
+	if(numChunks < 2)
+		return decode(isRaw, src, dest, len, state);
+	
+	decode_parallel_job job;
+	job.chunks = (decode_chunk*)malloc(numChunks * sizeof(decode_chunk));
+	if(!job.chunks)
+		return decode(isRaw, src, dest, len, state);
+	job.isRaw = isRaw;
+	job.src = (const unsigned char*)src;
+	job.dest = (unsigned char*)dest;
+	
+	// split the input on line boundaries, where the decoder state can be determined without decoding what came before
+	size_t pos = 0, n = 0;
+	do {
+		decode_chunk& chunk = job.chunks[n];
+		chunk.offset = pos;
+		chunk.state = n == 0 ? *state : YDEC_STATE_CRLF;
+		pos = (n == numChunks-1) ? len : decode_find_boundary(job.src, pos + chunkSize, len);
+		chunk.len = pos - chunk.offset;
+		n++;
+	} while(pos < len);
+	
+	run_tasks(runner, pool, &decode_parallel_task, &job, n);
+	
+	// join up the output of each chunk
+	size_t outLen = job.chunks[0].outLen;
+	for(size_t i=1; i<n; i++) {
+		const decode_chunk& chunk = job.chunks[i];
+		memmove(job.dest + outLen, job.dest + chunk.offset, chunk.outLen);
+		outLen += chunk.outLen;
+	}
+	*state = job.chunks[n-1].state;
+	free(job.chunks);
+	return outLen;
+}
@@ -274,6 +274,10 @@ void RapidYenc::decoder_set_rvv_funcs() {
 	_do_decode = &do_decode_simd<false, false, decoder_rvv_width, do_decode_rvv<false, false> >;
 	_do_decode_raw = &do_decode_simd<true, false, decoder_rvv_width, do_decode_rvv<true, false> >;
 	_do_decode_end_raw = &do_decode_simd<true, true, decoder_rvv_width, do_decode_rvv<true, true> >;
+	_do_decode_iov = &do_decode_iov_simd<false, decoder_rvv_width, do_decode_rvv<false, false> >;
+	_do_decode_raw_iov = &do_decode_iov_simd<true, decoder_rvv_width, do_decode_rvv<true, false> >;
+	_do_decode_end_raw_ring = &do_decode_end_raw_ring_simd<decoder_rvv_width, do_decode_rvv<true, true> >;
+	_decode_width = decoder_rvv_width();
 	_decode_isa = ISA_LEVEL_RVV;
 }
 #else
@@ -5,6 +5,7 @@
 #include "decoder_sse_base.h"
 
 void RapidYenc::decoder_sse_init(RapidYenc::SSELookups* HEDLEY_RESTRICT& lookups) {
+	if(lookups) return; // already set up, if the kernel was re-selected
 	ALIGN_ALLOC(lookups, sizeof(SSELookups), 16);
 	for(int i=0; i<256; i++) {
 		lookups->BitsSetTable256inv[i] = 8 - (
@@ -31,6 +32,10 @@ void RapidYenc::decoder_set_sse2_funcs() {
 	_do_decode = &do_decode_simd<false, false, sizeof(__m128i)*2, do_decode_sse<false, false, ISA_LEVEL_SSE2> >;
 	_do_decode_raw = &do_decode_simd<true, false, sizeof(__m128i)*2, do_decode_sse<true, false, ISA_LEVEL_SSE2> >;
 	_do_decode_end_raw = &do_decode_simd<true, true, sizeof(__m128i)*2, do_decode_sse<true, true, ISA_LEVEL_SSE2> >;
+	_do_decode_iov = &do_decode_iov_simd<false, sizeof(__m128i)*2, do_decode_sse<false, false, ISA_LEVEL_SSE2> >;
+	_do_decode_raw_iov = &do_decode_iov_simd<true, sizeof(__m128i)*2, do_decode_sse<true, false, ISA_LEVEL_SSE2> >;
+	_do_decode_end_raw_ring = &do_decode_end_raw_ring_simd<sizeof(__m128i)*2, do_decode_sse<true, true, ISA_LEVEL_SSE2> >;
+	_decode_width = sizeof(__m128i)*2;
 	_decode_isa = ISA_LEVEL_SSE2;
 }
 #else
@@ -9,6 +9,10 @@ void RapidYenc::decoder_set_ssse3_funcs() {
 	_do_decode = &do_decode_simd<false, false, sizeof(__m128i)*2, do_decode_sse<false, false, ISA_LEVEL_SSSE3> >;
 	_do_decode_raw = &do_decode_simd<true, false, sizeof(__m128i)*2, do_decode_sse<true, false, ISA_LEVEL_SSSE3> >;
 	_do_decode_end_raw = &do_decode_simd<true, true, sizeof(__m128i)*2, do_decode_sse<true, true, ISA_LEVEL_SSSE3> >;
+	_do_decode_iov = &do_decode_iov_simd<false, sizeof(__m128i)*2, do_decode_sse<false, false, ISA_LEVEL_SSSE3> >;
+	_do_decode_raw_iov = &do_decode_iov_simd<true, sizeof(__m128i)*2, do_decode_sse<true, false, ISA_LEVEL_SSSE3> >;
+	_do_decode_end_raw_ring = &do_decode_end_raw_ring_simd<sizeof(__m128i)*2, do_decode_sse<true, true, ISA_LEVEL_SSSE3> >;
+	_decode_width = sizeof(__m128i)*2;
 	_decode_isa = ISA_LEVEL_SSSE3;
 }
 #else
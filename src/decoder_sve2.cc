@@ -0,0 +1,164 @@
+#include "common.h"
+#include "decoder_common.h"
+#ifdef __ARM_FEATURE_SVE2
+
+namespace RapidYenc {
+
+// the decode loop requires a power-of-two block size, so any excess in non-power-of-two vector lengths (e.g. 384-bit) is left unused
+size_t decoder_sve2_width() {
+	size_t width = svcntb();
+	while(width & (width-1))
+		width &= width-1;
+	return width;
+}
+
+// moves the predicate up `shift` elements, with `shiftIn` entering at the bottom
+template<int shift>
+static HEDLEY_ALWAYS_INLINE svbool_t pred_lshift(svbool_t pg, svbool_t m, bool shiftIn) {
+	svuint8_t v = svdup_n_u8_z(m, 1);
+	for(int i=1; i<shift; i++)
+		v = svinsr_n_u8(v, 0);
+	return svcmpne_n_u8(pg, svinsr_n_u8(v, shiftIn), 0);
+}
+
+template<bool isRaw, bool searchEnd>
+HEDLEY_ALWAYS_INLINE void do_decode_sve2(const uint8_t* src, long& len, unsigned char*& outp, unsigned char& escFirst, uint16_t& nextMask) {
+	HEDLEY_ASSUME(escFirst == 0 || escFirst == 1);
+	HEDLEY_ASSUME(nextMask == 0 || nextMask == 1 || nextMask == 2);
+	const uint64_t vl = decoder_sve2_width();
+	const svbool_t pg = svwhilelt_b8((uint64_t)0, vl);
+	const svuint8_t index = svindex_u8(0, 1);
+	const svbool_t firstLane = svcmpeq_n_u8(pg, index, 0);
+	const svbool_t secondLane = svcmpeq_n_u8(pg, index, 1);
+	const svbool_t lastLane = svcmpeq_n_u8(pg, index, (uint8_t)(vl-1));
+	// MATCH compares against every byte in the same 128-bit segment, so the chars are repeated to fill it
+	const svuint8_t SPECIAL_CHARS = svdupq_n_u8(
+		'=','\r','\n','=', '\r','\n','=','\r', '\n','=','\r','\n', '=','\r','\n','='
+	);
+	
+	// a '.' following \r\n in the previous block, which needs to be removed
+	svbool_t dotFlag = svpfalse_b();
+	if(isRaw && nextMask)
+		dotFlag = nextMask == 1 ? firstLane : secondLane;
+	
+	decoder_set_nextMask<isRaw>(src, len, nextMask); // set this before the loop because we can't check src after it's been overwritten
+	
+	for(long i = -len; i; i += (long)vl) {
+		svuint8_t data = svld1_u8(pg, src+i);
+		svbool_t special = svmatch_u8(pg, data, SPECIAL_CHARS);
+		if(isRaw) {
+			special = svorr_b_z(pg, special, dotFlag);
+			dotFlag = svpfalse_b();
+		}
+		
+		if(svptest_any(pg, special)) {
+			svbool_t cmpEq = svcmpeq_n_u8(pg, data, '=');
+			
+			// handle \r\n. sequences
+			// RFC3977 requires the first dot on a line to be stripped, due to dot-stuffing
+			if((isRaw || searchEnd) && svptest_any(pg, svbic_b_z(pg, special, cmpEq))) {
+				svuint8_t tmpData2 = svld1_u8(pg, src+i+2);
+				svbool_t match2Eq, match0Cr, match2CrXDt;
+				if(searchEnd)
+					match2Eq = svcmpeq_n_u8(pg, tmpData2, '=');
+				if(isRaw) {
+					// find patterns of \r_.
+					match0Cr = svcmpeq_n_u8(pg, data, '\r');
+					match2CrXDt = svcmpeq_n_u8(match0Cr, tmpData2, '.');
+				}
+				
+				if(isRaw && LIKELIHOOD(0.002, svptest_any(pg, match2CrXDt))) {
+					// merge matches for \r\n.
+					svbool_t match1Nl = svcmpeq_n_u8(match0Cr, svld1_u8(pg, src+i+1), '\n');
+					svbool_t match2NlDot = svand_b_z(pg, match2CrXDt, match1Nl);
+					if(searchEnd) {
+						// match instances of \r\n.\r\n and \r\n.=y
+						svuint8_t tmpData3 = svld1_u8(pg, src+i+3);
+						svuint8_t tmpData4 = svld1_u8(pg, src+i+4);
+						svbool_t matchEnd = svorr_b_z(pg,
+							svcmpeq_n_u8(svcmpeq_n_u8(match2NlDot, tmpData3, '\r'), tmpData4, '\n'),
+							svcmpeq_n_u8(svcmpeq_n_u8(match2NlDot, tmpData3, '='), tmpData4, 'y')
+						);
+						// match \r\n=y
+						matchEnd = svorr_b_z(pg, matchEnd, svcmpeq_n_u8(svand_b_z(pg, match2Eq, match1Nl), tmpData3, 'y'));
+						if(LIKELIHOOD(0.002, svptest_any(pg, matchEnd))) {
+							// terminator found
+							// there's probably faster ways to do this, but reverting to scalar code should be good enough
+							len += i;
+							nextMask = decoder_set_nextMask<isRaw>(src+i, (unsigned)svptest_any(firstLane, special) | ((unsigned)svptest_any(secondLane, special) << 1));
+							break;
+						}
+					}
+					special = svorr_b_z(pg, special, pred_lshift<2>(pg, match2NlDot, false));
+					// matches in the last two positions carry over to the start of the next block
+					dotFlag = svcmpne_n_u8(
+						svorr_b_z(pg, firstLane, secondLane),
+						svtbl_u8(svdup_n_u8_z(match2NlDot, 1), svindex_u8((uint8_t)(vl-2), 1)),
+						0
+					);
+				}
+				else if(searchEnd) {
+					svbool_t match3EqY = svcmpeq_n_u8(match2Eq, svld1_u8(pg, src+i+3), 'y');
+					if(LIKELIHOOD(0.002, svptest_any(pg, match3EqY))) {
+						svbool_t match1LfEqY = svcmpeq_n_u8(match3EqY, svld1_u8(pg, src+i+1), '\n');
+						if(svptest_any(pg, svcmpeq_n_u8(match1LfEqY, data, '\r'))) {
+							len += i;
+							nextMask = decoder_set_nextMask<isRaw>(src+i, (unsigned)svptest_any(firstLane, special) | ((unsigned)svptest_any(secondLane, special) << 1));
+							break;
+						}
+					}
+				}
+			}
+			
+			// unescape chars following `=`
+			svbool_t eqShift1 = pred_lshift<1>(pg, cmpEq, escFirst);
+			if(LIKELIHOOD(0.0001, svptest_any(pg, svand_b_z(pg, special, eqShift1)))) {
+				// resolve invalid sequences of = to deal with cases like '===='
+				// there's no cheap way to do this with predicates, but it's rare enough that going through memory is fine
+				uint8_t eqFlags[256]; // maximum SVE vector length is 2048 bits
+				svst1_u8(pg, eqFlags, svdup_n_u8_z(cmpEq, 1));
+				unsigned char esc = escFirst;
+				for(uint64_t j=0; j<vl; j++) {
+					unsigned char isEq = eqFlags[j] & (esc ^ 1);
+					eqFlags[j] = esc;
+					esc = isEq;
+				}
+				eqShift1 = svcmpne_n_u8(pg, svld1_u8(pg, eqFlags), 0);
+				escFirst = esc;
+				// eliminate anything following a `=` from the special char mask; this eliminates cases of `=\r` so that they aren't removed
+				special = svbic_b_z(pg, special, eqShift1);
+			} else {
+				escFirst = svptest_any(lastLane, cmpEq);
+			}
+			data = svsub_n_u8_x(pg, data, 42);
+			data = svsub_n_u8_m(eqShift1, data, 64);
+			
+			// all that's left is to 'compress' the data (skip over special chars)
+			outp = svcompact_store_u8(outp, svnot_b_z(pg, special), data);
+		} else {
+			data = svsub_n_u8_x(pg, data, 42);
+			if(escFirst)
+				data = svsub_n_u8_m(firstLane, data, 64);
+			svst1_u8(pg, outp, data);
+			outp += vl;
+			escFirst = 0;
+		}
+	}
+}
+} // namespace
+
+void RapidYenc::decoder_set_sve2_funcs() {
+	_do_decode = &do_decode_simd<false, false, decoder_sve2_width, do_decode_sve2<false, false> >;
+	_do_decode_raw = &do_decode_simd<true, false, decoder_sve2_width, do_decode_sve2<true, false> >;
+	_do_decode_end_raw = &do_decode_simd<true, true, decoder_sve2_width, do_decode_sve2<true, true> >;
+	_do_decode_iov = &do_decode_iov_simd<false, decoder_sve2_width, do_decode_sve2<false, false> >;
+	_do_decode_raw_iov = &do_decode_iov_simd<true, decoder_sve2_width, do_decode_sve2<true, false> >;
+	_do_decode_end_raw_ring = &do_decode_end_raw_ring_simd<decoder_sve2_width, do_decode_sve2<true, true> >;
+	_decode_width = decoder_sve2_width();
+	_decode_isa = ISA_LEVEL_SVE2;
+}
+#else
+void RapidYenc::decoder_set_sve2_funcs() {
+	decoder_set_neon_funcs();
+}
+#endif
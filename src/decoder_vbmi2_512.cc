@@ -0,0 +1,179 @@
+#include "common.h"
+# include "decoder_common.h"
+
+// full 512-bit variant of the VBMI2 decoder; 128 bytes are processed per iteration, as two 64-byte halves, each with 64-bit masks
+#if defined(__AVX512VL__) && defined(__AVX512VBMI2__) && defined(__AVX512BW__) && (defined(__EVEX512__) || !(defined(__AVX10_1__) || defined(__EVEX256__))) && !defined(YENC_DISABLE_AVX256)
+
+#if defined(__tune_icelake_client__) || defined(__tune_icelake_server__) || defined(__tune_tigerlake__) || defined(__tune_rocketlake__) || defined(__tune_alderlake__) || defined(__tune_sapphirerapids__)
+# define COMPRESS_STORE512 _mm512_mask_compressstoreu_epi8
+#else
+// avoid uCode on Zen4
+# define COMPRESS_STORE512(dst, mask, vec) _mm512_storeu_si512((dst), _mm512_maskz_compress_epi8(mask, vec))
+#endif
+
+namespace RapidYenc {
+
+template<bool isRaw, bool searchEnd>
+HEDLEY_ALWAYS_INLINE void do_decode_avx512(const uint8_t* src, long& len, unsigned char*& p, unsigned char& _escFirst, uint16_t& _nextMask) {
+	HEDLEY_ASSUME(_escFirst == 0 || _escFirst == 1);
+	HEDLEY_ASSUME(_nextMask == 0 || _nextMask == 1 || _nextMask == 2);
+	uint64_t escFirst = _escFirst;
+	// a '.' following \r\n in the previous block is flagged by zeroing its position here, which makes it match the '.' entry in the lookup
+	__m512i minMask = _mm512_set1_epi8('.');
+	if(_nextMask && isRaw)
+		minMask = _mm512_maskz_mov_epi8(~(__mmask64)_nextMask, minMask);
+	
+	decoder_set_nextMask<isRaw>(src, len, _nextMask); // set this before the loop because we can't check src after it's been overwritten
+	
+	const __m512i specialLUT = _mm512_maskz_broadcast_i32x4(0xffff, _mm_set_epi8(
+		-1,'=','\r',-1,-1,'\n',-1,-1,-1,-1,-1,-1,-1,-1,-1,'.'
+	));
+	intptr_t i;
+	for(i = -len; i; i += sizeof(__m512i)*2) {
+		__m512i oDataA = _mm512_load_si512(src+i);
+		__m512i oDataB = _mm512_load_si512(src+i + sizeof(__m512i));
+		
+		// search for special chars
+		uint64_t maskA = _mm512_cmpeq_epi8_mask(oDataA, _mm512_shuffle_epi8(specialLUT, _mm512_min_epu8(oDataA, minMask)));
+		uint64_t maskB = _mm512_cmpeq_epi8_mask(oDataB, _mm512_shuffle_epi8(specialLUT, _mm512_min_epu8(oDataB, _mm512_set1_epi8('.'))));
+		__m512i dataA = _mm512_add_epi8(oDataA, _mm512_set1_epi8(-42));
+		__m512i dataB = _mm512_add_epi8(oDataB, _mm512_set1_epi8(-42));
+		
+		if((maskA | maskB) != 0) {
+			uint64_t maskEqA = _mm512_cmpeq_epi8_mask(oDataA, _mm512_set1_epi8('='));
+			uint64_t maskEqB = _mm512_cmpeq_epi8_mask(oDataB, _mm512_set1_epi8('='));
+			
+			// handle \r\n. sequences
+			// RFC3977 requires the first dot on a line to be stripped, due to dot-stuffing
+			if((isRaw || searchEnd) && LIKELIHOOD(0.45, (maskA ^ maskEqA) | (maskB ^ maskEqB))) {
+#define SHIFT_DATA_A(offs) _mm512_loadu_si512(src+i+offs)
+#define SHIFT_DATA_B(offs) _mm512_loadu_si512(src+i+offs + sizeof(__m512i))
+				__m512i tmpData2A = SHIFT_DATA_A(2);
+				__m512i tmpData2B = SHIFT_DATA_B(2);
+				uint64_t match2EqA, match2EqB;
+				if(searchEnd) {
+					match2EqA = _mm512_cmpeq_epi8_mask(tmpData2A, _mm512_set1_epi8('='));
+					match2EqB = _mm512_cmpeq_epi8_mask(tmpData2B, _mm512_set1_epi8('='));
+				}
+				
+				uint64_t match0CrA, match0CrB;
+				uint64_t match2CrXDtA, match2CrXDtB;
+				if(isRaw) {
+					// find patterns of \r_.
+					match0CrA = _mm512_cmpeq_epi8_mask(oDataA, _mm512_set1_epi8('\r'));
+					match0CrB = _mm512_cmpeq_epi8_mask(oDataB, _mm512_set1_epi8('\r'));
+					match2CrXDtA = _mm512_mask_cmpeq_epi8_mask(match0CrA, tmpData2A, _mm512_set1_epi8('.'));
+					match2CrXDtB = _mm512_mask_cmpeq_epi8_mask(match0CrB, tmpData2B, _mm512_set1_epi8('.'));
+				}
+				
+				if(isRaw && LIKELIHOOD(0.002, (match2CrXDtA | match2CrXDtB) != 0)) {
+					// merge matches for \r\n.
+					uint64_t match1NlA = _mm512_mask_cmpeq_epi8_mask(match0CrA, SHIFT_DATA_A(1), _mm512_set1_epi8('\n'));
+					uint64_t match1NlB = _mm512_mask_cmpeq_epi8_mask(match0CrB, SHIFT_DATA_B(1), _mm512_set1_epi8('\n'));
+					uint64_t match2NlDotA = match2CrXDtA & match1NlA;
+					uint64_t match2NlDotB = match2CrXDtB & match1NlB;
+					if(searchEnd) {
+						// match instances of \r\n.\r\n and \r\n.=y
+						__m512i tmpData3A = SHIFT_DATA_A(3);
+						__m512i tmpData3B = SHIFT_DATA_B(3);
+						__m512i tmpData4A = SHIFT_DATA_A(4);
+						__m512i tmpData4B = SHIFT_DATA_B(4);
+						uint64_t match4EndA = (
+							(_mm512_mask_cmpeq_epi8_mask(match2NlDotA, tmpData3A, _mm512_set1_epi8('\r')) & _mm512_cmpeq_epi8_mask(tmpData4A, _mm512_set1_epi8('\n')))
+							| (_mm512_mask_cmpeq_epi8_mask(match2NlDotA, tmpData3A, _mm512_set1_epi8('=')) & _mm512_cmpeq_epi8_mask(tmpData4A, _mm512_set1_epi8('y')))
+						);
+						uint64_t match4EndB = (
+							(_mm512_mask_cmpeq_epi8_mask(match2NlDotB, tmpData3B, _mm512_set1_epi8('\r')) & _mm512_cmpeq_epi8_mask(tmpData4B, _mm512_set1_epi8('\n')))
+							| (_mm512_mask_cmpeq_epi8_mask(match2NlDotB, tmpData3B, _mm512_set1_epi8('=')) & _mm512_cmpeq_epi8_mask(tmpData4B, _mm512_set1_epi8('y')))
+						);
+						// match \r\n=y
+						uint64_t match3EndA = _mm512_mask_cmpeq_epi8_mask(match2EqA & match1NlA, tmpData3A, _mm512_set1_epi8('y'));
+						uint64_t match3EndB = _mm512_mask_cmpeq_epi8_mask(match2EqB & match1NlB, tmpData3B, _mm512_set1_epi8('y'));
+						if(LIKELIHOOD(0.002, (match4EndA | match4EndB | match3EndA | match3EndB) != 0)) {
+							// terminator found
+							// there's probably faster ways to do this, but reverting to scalar code should be good enough
+							len += (long)i;
+							_nextMask = decoder_set_nextMask<isRaw>(src+i, (unsigned)maskA);
+							break;
+						}
+					}
+					maskB |= (match2NlDotB << 2) | (match2NlDotA >> 62);
+					maskA |= match2NlDotA << 2;
+					minMask = _mm512_maskz_mov_epi8(~(match2NlDotB >> 62), _mm512_set1_epi8('.'));
+				}
+				else if(searchEnd) {
+					uint64_t match3EqYA = _mm512_mask_cmpeq_epi8_mask(match2EqA, SHIFT_DATA_A(3), _mm512_set1_epi8('y'));
+					uint64_t match3EqYB = _mm512_mask_cmpeq_epi8_mask(match2EqB, SHIFT_DATA_B(3), _mm512_set1_epi8('y'));
+					if(LIKELIHOOD(0.002, (match3EqYA | match3EqYB) != 0)) {
+						uint64_t match1LfEqYA = _mm512_mask_cmpeq_epi8_mask(match3EqYA, SHIFT_DATA_A(1), _mm512_set1_epi8('\n'));
+						uint64_t match1LfEqYB = _mm512_mask_cmpeq_epi8_mask(match3EqYB, SHIFT_DATA_B(1), _mm512_set1_epi8('\n'));
+						if(
+							_mm512_mask_cmpeq_epi8_mask(match1LfEqYA, oDataA, _mm512_set1_epi8('\r'))
+							| _mm512_mask_cmpeq_epi8_mask(match1LfEqYB, oDataB, _mm512_set1_epi8('\r'))
+						) {
+							len += (long)i;
+							_nextMask = decoder_set_nextMask<isRaw>(src+i, (unsigned)maskA);
+							break;
+						}
+					}
+					if(isRaw) minMask = _mm512_set1_epi8('.');
+				}
+				else if(isRaw) // no \r_. found
+					minMask = _mm512_set1_epi8('.');
+#undef SHIFT_DATA_A
+#undef SHIFT_DATA_B
+			}
+			
+			// unescape chars following `=`; each half is resolved in turn, as an escape at the end of the first carries into the second
+			uint64_t maskEqShift1 = (maskEqA << 1) | escFirst;
+			if(LIKELIHOOD(0.0001, (maskA & maskEqShift1) != 0)) {
+				maskEqA = fix_eqMask<uint64_t>(maskEqA, maskEqShift1);
+				maskEqShift1 = (maskEqA << 1) | escFirst;
+				// eliminate anything following a `=` from the special char mask; this eliminates cases of `=\r` so that they aren't removed
+				maskA &= ~maskEqShift1;
+			}
+			dataA = _mm512_mask_add_epi8(dataA, maskEqShift1, dataA, _mm512_set1_epi8(-64));
+			escFirst = maskEqA >> 63;
+			
+			maskEqShift1 = (maskEqB << 1) | escFirst;
+			if(LIKELIHOOD(0.0001, (maskB & maskEqShift1) != 0)) {
+				maskEqB = fix_eqMask<uint64_t>(maskEqB, maskEqShift1);
+				maskEqShift1 = (maskEqB << 1) | escFirst;
+				maskB &= ~maskEqShift1;
+			}
+			dataB = _mm512_mask_add_epi8(dataB, maskEqShift1, dataB, _mm512_set1_epi8(-64));
+			escFirst = maskEqB >> 63;
+			
+			// all that's left is to 'compress' the data (skip over masked chars)
+			COMPRESS_STORE512(p, ~maskA, dataA);
+			p += sizeof(__m512i) - (unsigned int)_mm_popcnt_u64(maskA);
+			COMPRESS_STORE512(p, ~maskB, dataB);
+			p += sizeof(__m512i) - (unsigned int)_mm_popcnt_u64(maskB);
+		} else {
+			dataA = _mm512_mask_add_epi8(dataA, escFirst, dataA, _mm512_set1_epi8(-64));
+			_mm512_storeu_si512(p, dataA);
+			_mm512_storeu_si512(p + sizeof(__m512i), dataB);
+			p += sizeof(__m512i)*2;
+			escFirst = 0;
+		}
+	}
+	_escFirst = (unsigned char)escFirst;
+	_mm256_zeroupper();
+}
+} // namespace
+
+void RapidYenc::decoder_set_vbmi2_512_funcs() {
+	_do_decode = &do_decode_simd<false, false, sizeof(__m512i)*2, do_decode_avx512<false, false> >;
+	_do_decode_raw = &do_decode_simd<true, false, sizeof(__m512i)*2, do_decode_avx512<true, false> >;
+	_do_decode_end_raw = &do_decode_simd<true, true, sizeof(__m512i)*2, do_decode_avx512<true, true> >;
+	_do_decode_iov = &do_decode_iov_simd<false, sizeof(__m512i)*2, do_decode_avx512<false, false> >;
+	_do_decode_raw_iov = &do_decode_iov_simd<true, sizeof(__m512i)*2, do_decode_avx512<true, false> >;
+	_do_decode_end_raw_ring = &do_decode_end_raw_ring_simd<sizeof(__m512i)*2, do_decode_avx512<true, true> >;
+	_decode_width = sizeof(__m512i)*2;
+	_decode_isa = ISA_LEVEL_VBMI2 | ISA_FEATURE_EVEX512;
+}
+#else
+void RapidYenc::decoder_set_vbmi2_512_funcs() {
+	decoder_set_vbmi2_funcs();
+}
+#endif
@@ -110,6 +110,7 @@ size_t RapidYenc::do_encode_generic(int line_size, int* colOffset, const unsigne
 			} else {
 				*(p++) = c + 42;
 			}
+			col = line_size; // if this is the end of input, the next call needs to start on a new line
 		}
 		
 		if (i >= 0) break;
@@ -144,9 +145,61 @@ size_t RapidYenc::do_encode_generic(int line_size, int* colOffset, const unsigne
 	return p - dest;
 }
 
+size_t RapidYenc::do_encode_batch_generic(int line_size, encode_job* jobs, size_t numJobs) {
+	size_t total = 0;
+	for(size_t i=0; i<numJobs; i++) {
+		int col = 0;
+		jobs[i].outLen = 0;
+		if(jobs[i].len < 1) continue; // do_encode_generic always writes the first char
+		jobs[i].outLen = do_encode_generic(line_size, &col, (const unsigned char*)jobs[i].src, (unsigned char*)jobs[i].dest, jobs[i].len, 1);
+		total += jobs[i].outLen;
+	}
+	return total;
+}
+
+size_t RapidYenc::do_encode_iov_generic(int line_size, int* colOffset, const iovec_segment* segs, size_t numSegs, unsigned char* HEDLEY_RESTRICT dest, int doEnd) {
+	// the end of the article is handled with the last non-empty segment
+	while(numSegs && segs[numSegs-1].len < 1)
+		numSegs--;
+	unsigned char* p = dest;
+	for(size_t s=0; s<numSegs; s++) {
+		if(segs[s].len < 1) continue; // do_encode_generic always writes the first char
+		p += do_encode_generic(line_size, colOffset, (const unsigned char*)segs[s].base, p, segs[s].len, doEnd && s == numSegs-1);
+	}
+	return p - dest;
+}
+
+
+#include "encoder_length.h"
+
+uint16_t RapidYenc::encodeLineOverflowLUT[8*256];
+uint8_t RapidYenc::encodeLastCharLenLUT[256];
+static void encoder_length_init() {
+	using namespace RapidYenc;
+	for(int c=0; c<256; c++)
+		encodeLastCharLenLUT[c] = (escapedLUT[c] && c != '.'-42) ? 2 : 1;
+	for(int over=0; over<8; over++) {
+		for(int flags=0; flags<256; flags++) {
+			int chars = 0, cols = 0;
+			for(int bit=7; bit>=0; bit--) {
+				int charCols = 1 + ((flags >> bit) & 1);
+				if(cols + charCols > over) break;
+				cols += charCols;
+				chars++;
+			}
+			encodeLineOverflowLUT[over*256 + flags] = chars | (cols << 8);
+		}
+	}
+}
+
 
 namespace RapidYenc {
 	size_t (*_do_encode)(int, int*, const unsigned char* HEDLEY_RESTRICT, unsigned char* HEDLEY_RESTRICT, size_t, int) = &do_encode_generic;
+	size_t (*_do_encode_batch)(int, encode_job*, size_t) = &do_encode_batch_generic;
+	size_t (*_do_encode_iov)(int, int*, const iovec_segment*, size_t, unsigned char* HEDLEY_RESTRICT, int) = &do_encode_iov_generic;
+	size_t (*_encode_length)(int, int*, const unsigned char* HEDLEY_RESTRICT, size_t, int) = &do_encode_length;
+	void (*_encode_crit_mask)(const unsigned char* HEDLEY_RESTRICT, size_t, uint64_t* HEDLEY_RESTRICT, uint32_t* HEDLEY_RESTRICT) = &do_encode_crit_mask;
+	size_t (*_encode_length_masked)(int, int*, const unsigned char* HEDLEY_RESTRICT, const uint64_t* HEDLEY_RESTRICT, const uint32_t* HEDLEY_RESTRICT, size_t, int) = &do_encode_length_masked;
 	int _encode_isa = ISA_GENERIC;
 }
 
@@ -155,6 +208,8 @@ namespace RapidYenc {
 #  include "encoder_avx_base.h"
 static inline void encoder_native_init() {
 	RapidYenc::_do_encode = &do_encode_simd< RapidYenc::do_encode_avx2<ISA_NATIVE> >;
+	RapidYenc::_do_encode_batch = &do_encode_batch_simd< RapidYenc::do_encode_avx2<ISA_NATIVE> >;
+	RapidYenc::_do_encode_iov = &do_encode_iov_simd< RapidYenc::do_encode_avx2<ISA_NATIVE> >;
 	encoder_avx2_lut<ISA_NATIVE>();
 	RapidYenc::_encode_isa = ISA_NATIVE;
 }
@@ -162,6 +217,8 @@ static inline void encoder_native_init() {
 #  include "encoder_sse_base.h"
 static inline void encoder_native_init() {
 	RapidYenc::_do_encode = &do_encode_simd< RapidYenc::do_encode_sse<ISA_NATIVE> >;
+	RapidYenc::_do_encode_batch = &do_encode_batch_simd< RapidYenc::do_encode_sse<ISA_NATIVE> >;
+	RapidYenc::_do_encode_iov = &do_encode_iov_simd< RapidYenc::do_encode_sse<ISA_NATIVE> >;
 	encoder_sse_lut<ISA_NATIVE>();
 	RapidYenc::_encode_isa = ISA_NATIVE;
 }
@@ -170,12 +227,16 @@ static inline void encoder_native_init() {
 
 
 void RapidYenc::encoder_init() {
+	encoder_length_init();
 #ifdef PLATFORM_X86
 # if defined(YENC_BUILD_NATIVE) && YENC_BUILD_NATIVE!=0
 	encoder_native_init();
 # else
 	int use_isa = cpu_supports_isa();
-	if(use_isa >= ISA_LEVEL_VBMI2 && (encoder_has_avx10 || (use_isa & ISA_FEATURE_EVEX512)))
+	// the encoder is bound by shuffle throughput, so 512-bit vectors are only worth it if those units are full width
+	if(use_isa >= ISA_LEVEL_VBMI2 && (use_isa & ISA_FEATURE_FAST512) && (use_isa & ISA_FEATURE_FULL512))
+		encoder_vbmi2_512_init();
+	else if(use_isa >= ISA_LEVEL_VBMI2 && (encoder_has_avx10 || (use_isa & ISA_FEATURE_EVEX512)))
 		encoder_vbmi2_init();
 	else if(use_isa >= ISA_LEVEL_AVX2)
 		encoder_avx2_init();
@@ -188,6 +249,12 @@ void RapidYenc::encoder_init() {
 # endif
 #endif
 #ifdef PLATFORM_ARM
+# ifdef YENC_ENABLE_EXPERIMENTAL_KERNELS
+	// at 128-bit, SVE2 offers little over the NEON kernel, which has been tuned more
+	if(cpu_supports_sve2() && cpu_sve_length() > 16)
+		encoder_sve2_init();
+	else
+# endif
 	if(cpu_supports_neon())
 		encoder_neon_init();
 #endif
@@ -196,3 +263,42 @@ void RapidYenc::encoder_init() {
 		encoder_rvv_init();
 #endif
 }
+
+bool RapidYenc::encoder_set_kernel(int isa) {
+	if(isa == ISA_GENERIC) {
+		_do_encode = &do_encode_generic;
+		_do_encode_batch = &do_encode_batch_generic;
+		_do_encode_iov = &do_encode_iov_generic;
+		encoder_set_length_funcs();
+		_encode_isa = ISA_GENERIC;
+		return true;
+	}
+#if defined(PLATFORM_X86) && !(defined(YENC_BUILD_NATIVE) && YENC_BUILD_NATIVE!=0)
+	int use_isa = cpu_supports_isa();
+	if(isa == (ISA_LEVEL_VBMI2 | ISA_FEATURE_EVEX512) && use_isa >= ISA_LEVEL_VBMI2 && (use_isa & ISA_FEATURE_EVEX512))
+		encoder_vbmi2_512_init();
+	else if(isa == ISA_LEVEL_VBMI2 && use_isa >= ISA_LEVEL_VBMI2 && (encoder_has_avx10 || (use_isa & ISA_FEATURE_EVEX512)))
+		encoder_vbmi2_init();
+	else if(isa == ISA_LEVEL_AVX2 && use_isa >= ISA_LEVEL_AVX2)
+		encoder_avx2_init();
+	else if(isa == ISA_LEVEL_AVX && use_isa >= ISA_LEVEL_AVX)
+		encoder_avx_init();
+	else if(isa == ISA_LEVEL_SSSE3 && use_isa >= ISA_LEVEL_SSSE3)
+		encoder_ssse3_init();
+	else if(isa == ISA_LEVEL_SSE2)
+		encoder_sse2_init();
+#elif defined(PLATFORM_ARM)
+# ifdef YENC_ENABLE_EXPERIMENTAL_KERNELS
+	// SVE2 can be selected regardless of vector length, which allows all lengths to be tested under emulation
+	if(isa == ISA_LEVEL_SVE2 && cpu_supports_sve2())
+		encoder_sve2_init();
+	else
+# endif
+	if(isa == ISA_LEVEL_NEON && cpu_supports_neon())
+		encoder_neon_init();
+#else
+	(void)isa;
+#endif
+	// the init functions fall back to a lower level if the compiler didn't support the requested one
+	return _encode_isa == isa;
+}
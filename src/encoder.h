@@ -2,6 +2,7 @@
 #define __YENC_ENCODER_H
 
 #include "hedley.h"
+#include "parallel.h"
 
 namespace RapidYenc {
 
@@ -12,7 +13,30 @@ extern int _encode_isa;
 static inline size_t encode(int line_size, int* colOffset, const void* HEDLEY_RESTRICT src, void* HEDLEY_RESTRICT dest, size_t len, int doEnd) {
 	return (*_do_encode)(line_size, colOffset, (const unsigned char* HEDLEY_RESTRICT)src, (unsigned char*)dest, len, doEnd);
 }
+extern size_t (*_encode_length)(int, int*, const unsigned char* HEDLEY_RESTRICT, size_t, int);
+static inline size_t encode_length(int line_size, int* colOffset, const void* HEDLEY_RESTRICT src, size_t len, int doEnd) {
+	return (*_encode_length)(line_size, colOffset, (const unsigned char* HEDLEY_RESTRICT)src, len, doEnd);
+}
+
+// a single article to encode as part of a batch; this mirrors RapidYencEncodeJob in rapidyenc.h
+struct encode_job {
+	const void* src;
+	void* dest;
+	size_t len;
+	size_t outLen;
+};
+extern size_t (*_do_encode_batch)(int, encode_job*, size_t);
+static inline size_t encode_batch(int line_size, encode_job* jobs, size_t numJobs) {
+	return (*_do_encode_batch)(line_size, jobs, numJobs);
+}
+
+extern size_t (*_do_encode_iov)(int, int*, const iovec_segment*, size_t, unsigned char* HEDLEY_RESTRICT, int);
+static inline size_t encode_iov(int line_size, int* colOffset, const iovec_segment* segs, size_t numSegs, void* HEDLEY_RESTRICT dest, int doEnd) {
+	return (*_do_encode_iov)(line_size, colOffset, segs, numSegs, (unsigned char*)dest, doEnd);
+}
+size_t encode_parallel(int line_size, int* colOffset, const void* HEDLEY_RESTRICT src, void* HEDLEY_RESTRICT dest, size_t len, int doEnd, size_t numChunks, task_runner runner, void* pool);
 void encoder_init();
+bool encoder_set_kernel(int isa);
 static inline int encode_isa_level() {
 	return _encode_isa;
 }
@@ -3,10 +3,14 @@
 
 #if defined(__AVX__) && defined(__POPCNT__)
 #include "encoder_sse_base.h"
+#include "encoder_length.h"
 
 void RapidYenc::encoder_avx_init() {
 	_do_encode = &do_encode_simd< do_encode_sse<ISA_LEVEL_SSE4_POPCNT> >;
+	_do_encode_batch = &do_encode_batch_simd< do_encode_sse<ISA_LEVEL_SSE4_POPCNT> >;
+	_do_encode_iov = &do_encode_iov_simd< do_encode_sse<ISA_LEVEL_SSE4_POPCNT> >;
 	encoder_sse_lut<ISA_LEVEL_SSE4_POPCNT>();
+	encoder_set_length_funcs();
 	_encode_isa = ISA_LEVEL_AVX;
 }
 #else
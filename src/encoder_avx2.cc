@@ -3,10 +3,14 @@
 
 #if defined(__AVX2__) && !defined(YENC_DISABLE_AVX256)
 #include "encoder_avx_base.h"
+#include "encoder_length.h"
 
 void RapidYenc::encoder_avx2_init() {
 	_do_encode = &do_encode_simd< do_encode_avx2<ISA_LEVEL_AVX2> >;
+	_do_encode_batch = &do_encode_batch_simd< do_encode_avx2<ISA_LEVEL_AVX2> >;
+	_do_encode_iov = &do_encode_iov_simd< do_encode_avx2<ISA_LEVEL_AVX2> >;
 	encoder_avx2_lut<ISA_LEVEL_AVX2>();
+	encoder_set_length_funcs();
 	_encode_isa = ISA_LEVEL_AVX2;
 }
 #else
@@ -33,6 +33,7 @@ static inline void fill_eolLastChar(uint32_t* table) {
 template<enum YEncDecIsaLevel use_isa>
 static void encoder_avx2_lut() {
 	if(use_isa >= ISA_LEVEL_VBMI2) {
+		if(lookupsVBMI2) return; // already set up, if the kernel was re-selected
 		ALIGN_ALLOC(lookupsVBMI2, sizeof(*lookupsVBMI2), 32);
 		fill_eolLastChar(lookupsVBMI2->eolLastChar);
 		for(int i=0; i<65536; i++) {
@@ -49,6 +50,7 @@ static void encoder_avx2_lut() {
 			lookupsVBMI2->expand[i] = expand;
 		}
 	} else {
+		if(lookupsAVX2) return;
 		ALIGN_ALLOC(lookupsAVX2, sizeof(*lookupsAVX2), 32);
 		fill_eolLastChar(lookupsAVX2->eolLastChar);
 		for(int i=0; i<65536; i++) {
@@ -1,14 +1,18 @@
 #ifndef __YENC_ENCODER_COMMON
 #define __YENC_ENCODER_COMMON
 
+#include "encoder.h"
+
 namespace RapidYenc {
 	void encoder_sse2_init();
 	void encoder_ssse3_init();
 	void encoder_avx_init();
 	void encoder_avx2_init();
 	void encoder_vbmi2_init();
+	void encoder_vbmi2_512_init();
 	extern const bool encoder_has_avx10;
 	void encoder_neon_init();
+	void encoder_sve2_init();
 	void encoder_rvv_init();
 	
 	// lookup tables for scalar processing
@@ -16,12 +20,19 @@ namespace RapidYenc {
 	extern const uint16_t escapedLUT[256];
 	
 	size_t do_encode_generic(int line_size, int* colOffset, const unsigned char* HEDLEY_RESTRICT src, unsigned char* HEDLEY_RESTRICT dest, size_t len, int doEnd);
+	size_t do_encode_batch_generic(int line_size, encode_job* jobs, size_t numJobs);
+	size_t do_encode_iov_generic(int line_size, int* colOffset, const iovec_segment* segs, size_t numSegs, unsigned char* HEDLEY_RESTRICT dest, int doEnd);
+	
+	// for computing encoded lengths without encoding (see encoder_length.h): `_encode_crit_mask` sets bit n of the mask for each critical (always escaped) character at src[n], and counts them for every 64 characters (prefix[n/64] = critical chars before src[n&~63])
+	// `_encode_length_masked` then gives the length `encode` would return, and updates colOffset in the same way
+	extern void (*_encode_crit_mask)(const unsigned char* HEDLEY_RESTRICT, size_t, uint64_t* HEDLEY_RESTRICT, uint32_t* HEDLEY_RESTRICT);
+	extern size_t (*_encode_length_masked)(int, int*, const unsigned char* HEDLEY_RESTRICT, const uint64_t* HEDLEY_RESTRICT, const uint32_t* HEDLEY_RESTRICT, size_t, int);
 }
 
 
 
 template<void(&kernel)(int, int*, const uint8_t* HEDLEY_RESTRICT, uint8_t* HEDLEY_RESTRICT&, size_t&)>
-static size_t do_encode_simd(int line_size, int* colOffset, const unsigned char* HEDLEY_RESTRICT src, unsigned char* HEDLEY_RESTRICT dest, size_t len, int doEnd) {
+static HEDLEY_ALWAYS_INLINE size_t do_encode_simd(int line_size, int* colOffset, const unsigned char* HEDLEY_RESTRICT src, unsigned char* HEDLEY_RESTRICT dest, size_t len, int doEnd) {
 	if(len < 1) return 0;
 	if(line_size < 12) { // short lines probably not worth processing in a SIMD way
 		// we assume at least the first and last char exist in the line, and since the first char could be escaped, and SIMD encoder assumes at least one non-first/last char, assumption means that line size has to be >= 4
@@ -68,7 +79,11 @@ static size_t do_encode_simd(int line_size, int* colOffset, const unsigned char*
 				} else {
 					*(p++) = c + 42;
 				}
-				if(i == 0) break;
+				if(i == 0) {
+					// mark the line as full, so that a subsequent call starts on a new line
+					*colOffset = line_size;
+					break;
+				}
 				c = es[i++];
 			}
 			
@@ -100,4 +115,87 @@ static size_t do_encode_simd(int line_size, int* colOffset, const unsigned char*
 	return p - dest;
 }
 
+// encodes each job as a complete article; having the encoder inlined here means that the dispatch, line size check and kernel setup (loading constants etc) only need to happen once for the whole batch
+template<void(&kernel)(int, int*, const uint8_t* HEDLEY_RESTRICT, uint8_t* HEDLEY_RESTRICT&, size_t&)>
+static size_t do_encode_batch_simd(int line_size, RapidYenc::encode_job* jobs, size_t numJobs) {
+	if(line_size < 12)
+		return RapidYenc::do_encode_batch_generic(line_size, jobs, numJobs);
+	
+	size_t total = 0;
+	for(size_t i=0; i<numJobs; i++) {
+		int col = 0;
+		jobs[i].outLen = do_encode_simd<kernel>(line_size, &col, (const uint8_t*)jobs[i].src, (uint8_t*)jobs[i].dest, jobs[i].len, 1);
+		total += jobs[i].outLen;
+	}
+	return total;
+}
+
+// for encoding scattered input: the unprocessed end of a segment is copied into a small buffer along with the start of the next, so that the SIMD kernel can continue across the seam, instead of falling back to the scalar loop at the end of every segment
+#define ENCODE_IOV_STITCH_SIZE 2048
+#define ENCODE_IOV_CARRY_MAX (ENCODE_IOV_STITCH_SIZE/2)
+
+template<void(&kernel)(int, int*, const uint8_t* HEDLEY_RESTRICT, uint8_t* HEDLEY_RESTRICT&, size_t&)>
+static size_t do_encode_iov_simd(int line_size, int* colOffset, const RapidYenc::iovec_segment* segs, size_t numSegs, unsigned char* HEDLEY_RESTRICT dest, int doEnd) {
+	if(line_size < 12)
+		return RapidYenc::do_encode_iov_generic(line_size, colOffset, segs, numSegs, dest, doEnd);
+	if(*colOffset < 0) *colOffset = 0; // sanity check
+	
+	uint8_t stitch[ENCODE_IOV_STITCH_SIZE];
+	size_t carry = 0; // number of bytes at the start of `stitch` which haven't been encoded yet
+	uint8_t* p = dest;
+	for(size_t s=0; s<numSegs; s++) {
+		const uint8_t* src = (const uint8_t*)segs[s].base;
+		size_t len = segs[s].len;
+		if(!len) continue; // empty segments may have a NULL base
+		
+		while(carry && len) {
+			// the kernel leaves a similar number of bytes unprocessed each time, so taking a little more than what's carried over should be enough to get past the seam
+			size_t take = carry + 64;
+			if(take > ENCODE_IOV_STITCH_SIZE - carry) take = ENCODE_IOV_STITCH_SIZE - carry;
+			if(take > len) take = len;
+			memcpy(stitch + carry, src, take);
+			src += take;
+			len -= take;
+			size_t stitchLen = carry + take;
+			size_t remaining = stitchLen;
+			kernel(line_size, colOffset, stitch + stitchLen, p, remaining);
+			if(remaining <= take) {
+				// kernel got past the seam, so continue from within the segment
+				src -= remaining;
+				len += remaining;
+				carry = 0;
+			} else if(remaining <= ENCODE_IOV_CARRY_MAX) {
+				memmove(stitch, stitch + stitchLen - remaining, remaining);
+				carry = remaining;
+			} else {
+				// kernel can't process this (line size too small for it), so encode it the slow way
+				p += do_encode_simd<kernel>(line_size, colOffset, stitch + stitchLen - remaining, p, remaining, 0);
+				carry = 0;
+			}
+		}
+		if(carry) continue;
+		
+		size_t remaining = len;
+		kernel(line_size, colOffset, src + len, p, remaining);
+		if(remaining <= ENCODE_IOV_CARRY_MAX) {
+			memcpy(stitch, src + len - remaining, remaining);
+			carry = remaining;
+		} else
+			p += do_encode_simd<kernel>(line_size, colOffset, src + len - remaining, p, remaining, 0);
+	}
+	
+	// finish off what's left with the scalar loop
+	p += do_encode_simd<kernel>(line_size, colOffset, stitch, p, carry, 0);
+	if(doEnd && p != dest) {
+		unsigned char lc = *(p-1);
+		if(lc == '\t' || lc == ' ') {
+			p[-1] = '=';
+			*p = lc+64;
+			p++;
+			(*colOffset)++;
+		}
+	}
+	return p - dest;
+}
+
 #endif /* __YENC_ENCODER_COMMON */
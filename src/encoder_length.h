@@ -0,0 +1,236 @@
+#ifndef __YENC_ENCODER_LENGTH_H
+#define __YENC_ENCODER_LENGTH_H
+
+// computes encoded lengths without encoding: a bitmask of critical characters is built with SIMD, then lines are stepped through using this mask
+// this is included by each ISA-specific encoder, so that the mask and popcount use the best available instructions
+
+#include "encoder_common.h"
+#include "encoder.h"
+
+namespace RapidYenc {
+	// when a line overflows by 0-7 columns, gives the number of characters (low byte) and columns (high byte) to remove from the end of the line, so that it's filled in the same way as the encoder does
+	// indexed by the overflow amount and `crit_before8` at the end of the line
+	extern uint16_t encodeLineOverflowLUT[8*256];
+	// output length of a character placed at the end of a line
+	extern uint8_t encodeLastCharLenLUT[256];
+}
+
+static HEDLEY_ALWAYS_INLINE unsigned popcnt64(uint64_t n) {
+#if defined(__GNUC__) && (defined(__POPCNT__) || defined(__aarch64__))
+	return __builtin_popcountll(n);
+#else
+	n -= (n >> 1) & 0x5555555555555555ULL;
+	n = (n & 0x3333333333333333ULL) + ((n >> 2) & 0x3333333333333333ULL);
+	n = (n + (n >> 4)) & 0x0f0f0f0f0f0f0f0fULL;
+	return (unsigned)((n * 0x0101010101010101ULL) >> 56);
+#endif
+}
+
+static void do_encode_crit_mask(const unsigned char* HEDLEY_RESTRICT src, size_t len, uint64_t* HEDLEY_RESTRICT mask, uint32_t* HEDLEY_RESTRICT prefix) {
+	using namespace RapidYenc;
+	uint32_t count = 0;
+#if defined(__AVX2__) && !defined(YENC_DISABLE_AVX256)
+	const __m256i cmpNul = _mm256_set1_epi8(-42);
+	const __m256i cmpLf = _mm256_set1_epi8('\n'-42);
+	const __m256i cmpCr = _mm256_set1_epi8('\r'-42);
+	const __m256i cmpEq = _mm256_set1_epi8('='-42);
+	for(; len >= 64; len -= 64, src += 64) {
+		uint64_t m = 0;
+		for(int j=0; j<2; j++) {
+			__m256i data = _mm256_loadu_si256((const __m256i*)(src + j*32));
+			__m256i crit = _mm256_or_si256(
+				_mm256_or_si256(_mm256_cmpeq_epi8(data, cmpNul), _mm256_cmpeq_epi8(data, cmpLf)),
+				_mm256_or_si256(_mm256_cmpeq_epi8(data, cmpCr), _mm256_cmpeq_epi8(data, cmpEq))
+			);
+			m |= (uint64_t)(uint32_t)_mm256_movemask_epi8(crit) << (j*32);
+		}
+		*mask++ = m;
+		*prefix++ = count;
+		count += popcnt64(m);
+	}
+#elif defined(__SSE2__)
+	const __m128i cmpNul = _mm_set1_epi8(-42);
+	const __m128i cmpLf = _mm_set1_epi8('\n'-42);
+	const __m128i cmpCr = _mm_set1_epi8('\r'-42);
+	const __m128i cmpEq = _mm_set1_epi8('='-42);
+	for(; len >= 64; len -= 64, src += 64) {
+		uint64_t m = 0;
+		for(int j=0; j<4; j++) {
+			__m128i data = _mm_loadu_si128((const __m128i*)(src + j*16));
+			__m128i crit = _mm_or_si128(
+				_mm_or_si128(_mm_cmpeq_epi8(data, cmpNul), _mm_cmpeq_epi8(data, cmpLf)),
+				_mm_or_si128(_mm_cmpeq_epi8(data, cmpCr), _mm_cmpeq_epi8(data, cmpEq))
+			);
+			m |= (uint64_t)(unsigned)_mm_movemask_epi8(crit) << (j*16);
+		}
+		*mask++ = m;
+		*prefix++ = count;
+		count += popcnt64(m);
+	}
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+	const uint8x16_t cmpNul = vdupq_n_u8(-42);
+	const uint8x16_t cmpLf = vdupq_n_u8('\n'-42);
+	const uint8x16_t cmpCr = vdupq_n_u8('\r'-42);
+	const uint8x16_t cmpEq = vdupq_n_u8('='-42);
+	const uint8x16_t bitSel = vmakeq_u8(1,2,4,8,16,32,64,128, 1,2,4,8,16,32,64,128);
+	for(; len >= 64; len -= 64, src += 64) {
+		uint8x16_t crit[4];
+		for(int j=0; j<4; j++) {
+			uint8x16_t data = vld1q_u8(src + j*16);
+			crit[j] = vandq_u8(vorrq_u8(
+				vorrq_u8(vceqq_u8(data, cmpNul), vceqq_u8(data, cmpLf)),
+				vorrq_u8(vceqq_u8(data, cmpCr), vceqq_u8(data, cmpEq))
+			), bitSel);
+		}
+		uint8x16_t m = vpaddq_u8(vpaddq_u8(crit[0], crit[1]), vpaddq_u8(crit[2], crit[3]));
+		m = vpaddq_u8(m, m);
+		*mask = vgetq_lane_u64(vreinterpretq_u64_u8(m), 0);
+		*prefix++ = count;
+		count += popcnt64(*mask++);
+	}
+#else
+	for(; len >= 64; len -= 64, src += 64) {
+		uint64_t m = 0;
+		for(int i=0; i<64; i++)
+			m |= (uint64_t)(escapeLUT[src[i]] == 0) << i;
+		*mask++ = m;
+		*prefix++ = count;
+		count += popcnt64(m);
+	}
+#endif
+	if(len) {
+		uint64_t m = 0;
+		for(unsigned i=0; i<len; i++)
+			m |= (uint64_t)(escapeLUT[src[i]] == 0) << i;
+		*mask = m;
+		*prefix = count;
+	}
+}
+
+static HEDLEY_ALWAYS_INLINE unsigned crit_at(const uint64_t* mask, size_t pos) {
+	return (mask[pos >> 6] >> (pos & 63)) & 1;
+}
+// number of critical characters before `pos`
+static HEDLEY_ALWAYS_INLINE uint32_t crit_before(const uint64_t* mask, const uint32_t* prefix, size_t pos) {
+	return prefix[pos >> 6] + popcnt64(mask[pos >> 6] & ((1ULL << (pos & 63)) - 1));
+}
+// critical char flags for the 8 characters before `pos` (MSB = character at pos-1)
+static HEDLEY_ALWAYS_INLINE unsigned crit_before8(const uint64_t* mask, size_t pos) {
+	pos -= 8;
+	uint64_t m = mask[pos >> 6] >> (pos & 63);
+	if((pos & 63) > 56)
+		m |= mask[(pos >> 6) + 1] << (64 - (pos & 63));
+	return m & 0xff;
+}
+
+static size_t do_encode_length_masked(int line_size, int* colOffset, const unsigned char* HEDLEY_RESTRICT src, const uint64_t* HEDLEY_RESTRICT critMask, const uint32_t* HEDLEY_RESTRICT critPrefix, size_t len, int doEnd) {
+	using namespace RapidYenc;
+	if(len < 1) return 0;
+	// this follows the same steps as do_encode_generic, but only tracks lengths
+	size_t outLen = 0;
+	size_t i = 0;
+	size_t col = *colOffset < 0 ? 0 : *colOffset;
+	const size_t lineSize = line_size;
+	bool lastIsMiddle = false; // whether the last character processed can be a trailing space/tab
+	
+	if(col == 0) {
+		col = escapedLUT[src[i++]] ? 2 : 1;
+		outLen = col;
+	}
+	
+	while(i < len) {
+		// fast path for whole lines: assume the line is filled with non-critical characters, then use the LUT to correct for the overflow caused by critical ones
+		while(col+1 < lineSize) {
+			size_t need = lineSize - 1 - col;
+			size_t end = i + need;
+			if(end+1 >= len || i < 8) break; // need the last char + first char of the next line to be available, and 8 chars before for the LUT
+			size_t over = (uint32_t)(crit_before(critMask, critPrefix, end) - crit_before(critMask, critPrefix, i));
+			size_t chars = need, width = need + over;
+			while(HEDLEY_UNLIKELY(over >= 8)) {
+				// back off 4 characters at a time; as these take at most 8 columns, the line remains filled
+				unsigned removed = 4 + (unsigned)popcnt64(crit_before8(critMask, i + chars) >> 4);
+				chars -= 4;
+				width -= removed;
+				over -= removed;
+			}
+			unsigned adjust = encodeLineOverflowLUT[over*256 + crit_before8(critMask, i + chars)];
+			chars -= adjust & 0xff;
+			width -= adjust >> 8;
+			i += chars;
+			outLen += width;
+			// if the line isn't filled yet, the last line char follows (done without branching, as this is unpredictable)
+			size_t hasLast = col + width < lineSize;
+			outLen += encodeLastCharLenLUT[src[i]] & -hasLast;
+			i += hasLast;
+			// EOL + first char of the next line
+			col = escapedLUT[src[i++]] ? 2 : 1;
+			outLen += col + 2;
+		}
+		if(i >= len) break;
+		
+		if(col+1 < lineSize) {
+			// find the fewest characters which fill the line: each critical char takes up two columns
+			size_t need = lineSize - 1 - col;
+			size_t chars = len - i < need ? len - i : need;
+			size_t width = chars + crit_before(critMask, critPrefix, i + chars - 1) + crit_at(critMask, i + chars - 1) - crit_before(critMask, critPrefix, i);
+			while(width > need && width - 1 - crit_at(critMask, i + chars - 1) >= need) {
+				width -= 1 + crit_at(critMask, i + chars - 1);
+				chars--;
+			}
+			i += chars;
+			col += width;
+			outLen += width;
+			lastIsMiddle = true;
+			if(i >= len) break;
+		}
+		
+		if(col < lineSize) {
+			// last line char
+			uint8_t c = src[i++];
+			outLen += (escapedLUT[c] && c != '.'-42) ? 2 : 1;
+			col = lineSize;
+			lastIsMiddle = false;
+			if(i >= len) break;
+		}
+		
+		// EOL + first char of the next line
+		col = escapedLUT[src[i++]] ? 2 : 1;
+		outLen += col + 2;
+		lastIsMiddle = false;
+	}
+	
+	if(doEnd && lastIsMiddle) {
+		uint8_t c = src[len-1] + 42;
+		if(c == '\t' || c == ' ') {
+			outLen++;
+			col++;
+		}
+	}
+	*colOffset = (int)col;
+	return outLen;
+}
+
+// amount of input to process at a time in do_encode_length; the mask for this is kept on the stack
+#define ENCODE_LENGTH_BLOCK 16384
+
+static size_t do_encode_length(int line_size, int* colOffset, const unsigned char* HEDLEY_RESTRICT src, size_t len, int doEnd) {
+	uint64_t mask[ENCODE_LENGTH_BLOCK/64];
+	uint32_t prefix[ENCODE_LENGTH_BLOCK/64];
+	size_t outLen = 0;
+	while(len > ENCODE_LENGTH_BLOCK) {
+		do_encode_crit_mask(src, ENCODE_LENGTH_BLOCK, mask, prefix);
+		outLen += do_encode_length_masked(line_size, colOffset, src, mask, prefix, ENCODE_LENGTH_BLOCK, 0);
+		src += ENCODE_LENGTH_BLOCK;
+		len -= ENCODE_LENGTH_BLOCK;
+	}
+	do_encode_crit_mask(src, len, mask, prefix);
+	return outLen + do_encode_length_masked(line_size, colOffset, src, mask, prefix, len, doEnd);
+}
+
+static inline void encoder_set_length_funcs() {
+	RapidYenc::_encode_length = &do_encode_length;
+	RapidYenc::_encode_crit_mask = &do_encode_crit_mask;
+	RapidYenc::_encode_length_masked = &do_encode_length_masked;
+}
+
+#endif
@@ -523,6 +523,8 @@ HEDLEY_ALWAYS_INLINE void do_encode_neon(int line_size, int* colOffset, const ui
 
 void RapidYenc::encoder_neon_init() {
 	_do_encode = &do_encode_simd<do_encode_neon>;
+	_do_encode_batch = &do_encode_batch_simd<do_encode_neon>;
+	_do_encode_iov = &do_encode_iov_simd<do_encode_neon>;
 	_encode_isa = ISA_LEVEL_NEON;
 	// generate shuf LUT
 	for(int i=0; i<256; i++) {
@@ -0,0 +1,101 @@
+#include "common.h"
+#include "encoder_common.h"
+#include "encoder.h"
+#include "parallel.h"
+#include <string.h>
+
+// the SIMD kernels may write past the end of their output, which would clobber the start of the following chunk's output
+// to avoid this, the last few bytes of each chunk are encoded into a temporary buffer, then copied over
+#define PARALLEL_TAIL_SIZE 256
+
+namespace RapidYenc {
+	struct encode_chunk {
+		const unsigned char* src;
+		unsigned char* dest;
+		size_t len;
+		int col;
+	};
+	struct encode_parallel_job {
+		int line_size;
+		int doEnd;
+		const unsigned char* src;
+		uint64_t* critMask;
+		uint32_t* critPrefix;
+		encode_chunk* chunks;
+		size_t numChunks;
+	};
+}
+
+static void encode_parallel_mask_task(void* data, size_t index) {
+	RapidYenc::encode_parallel_job* job = (RapidYenc::encode_parallel_job*)data;
+	const RapidYenc::encode_chunk& chunk = job->chunks[index];
+	size_t word = (chunk.src - job->src) >> 6;
+	(*RapidYenc::_encode_crit_mask)(chunk.src, chunk.len, job->critMask + word, job->critPrefix + word);
+}
+
+static void encode_parallel_encode_task(void* data, size_t index) {
+	RapidYenc::encode_parallel_job* job = (RapidYenc::encode_parallel_job*)data;
+	RapidYenc::encode_chunk& chunk = job->chunks[index];
+	if(index == job->numChunks-1) {
+		// last chunk can overflow into the padding at the end of dest
+		RapidYenc::encode(job->line_size, &chunk.col, chunk.src, chunk.dest, chunk.len, job->doEnd);
+		return;
+	}
+	
+	size_t bodyLen = chunk.len - PARALLEL_TAIL_SIZE;
+	size_t outLen = RapidYenc::encode(job->line_size, &chunk.col, chunk.src, chunk.dest, bodyLen, 0);
+	// worst case for the tail is every character being escaped and on its own line, plus SIMD overflow
+	unsigned char tail[PARALLEL_TAIL_SIZE*4 + 256];
+	size_t tailLen = RapidYenc::encode(job->line_size, &chunk.col, chunk.src + bodyLen, tail, PARALLEL_TAIL_SIZE, 0);
+	memcpy(chunk.dest + outLen, tail, tailLen);
+}
+
+size_t RapidYenc::encode_parallel(int line_size, int* colOffset, const void* HEDLEY_RESTRICT src, void* HEDLEY_RESTRICT dest, size_t len, int doEnd, size_t numChunks, task_runner runner, void* pool) {
+	if(*colOffset < 0) *colOffset = 0; // sanity check
+	if(numChunks < 2) numChunks = 1;
+	
+	// chunks are a multiple of 64 bytes, so that each starts on a word in the critical char mask
+	size_t chunkSize = ((len / numChunks) + 63) & ~(size_t)63;
+	if(chunkSize < PARALLEL_MIN_CHUNK) chunkSize = PARALLEL_MIN_CHUNK;
+	numChunks = (len + chunkSize-1) / chunkSize;
+	if(numChunks < 2)
+		return encode(line_size, colOffset, src, dest, len, doEnd);
+	
+	encode_parallel_job job;
+	size_t maskWords = (len+63) >> 6;
+	job.critMask = (uint64_t*)malloc(maskWords * (sizeof(uint64_t) + sizeof(uint32_t)));
+	job.chunks = (encode_chunk*)malloc(numChunks * sizeof(encode_chunk));
+	if(!job.critMask || !job.chunks) {
+		// can't do this in parallel, fall back to a serial encode
+		free(job.critMask);
+		free(job.chunks);
+		return encode(line_size, colOffset, src, dest, len, doEnd);
+	}
+	job.critPrefix = (uint32_t*)(job.critMask + maskWords);
+	job.line_size = line_size;
+	job.doEnd = doEnd;
+	job.src = (const unsigned char*)src;
+	job.numChunks = numChunks;
+	for(size_t i=0; i<numChunks; i++) {
+		job.chunks[i].src = job.src + i*chunkSize;
+		job.chunks[i].len = (i == numChunks-1) ? len - i*chunkSize : chunkSize;
+	}
+	
+	// find critical characters, then use these to quickly compute the column and output position at the start of each chunk
+	run_tasks(runner, pool, &encode_parallel_mask_task, &job, numChunks);
+	unsigned char* p = (unsigned char*)dest;
+	int col = *colOffset;
+	for(size_t i=0; i<numChunks; i++) {
+		encode_chunk& chunk = job.chunks[i];
+		chunk.col = col;
+		chunk.dest = p;
+		size_t word = i * (chunkSize >> 6);
+		p += (*_encode_length_masked)(line_size, &col, chunk.src, job.critMask + word, job.critPrefix + word, chunk.len, doEnd && i == numChunks-1);
+	}
+	free(job.critMask);
+	
+	run_tasks(runner, pool, &encode_parallel_encode_task, &job, numChunks);
+	*colOffset = job.chunks[numChunks-1].col;
+	free(job.chunks);
+	return p - (unsigned char*)dest;
+}
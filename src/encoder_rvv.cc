@@ -200,6 +200,8 @@ HEDLEY_ALWAYS_INLINE void do_encode_rvv(int line_size, int* colOffset, const uin
 
 void RapidYenc::encoder_rvv_init() {
 	_do_encode = &do_encode_simd<do_encode_rvv>;
+	_do_encode_batch = &do_encode_batch_simd<do_encode_rvv>;
+	_do_encode_iov = &do_encode_iov_simd<do_encode_rvv>;
 	_encode_isa = ISA_LEVEL_RVV;
 }
 #else
@@ -3,10 +3,14 @@
 
 #ifdef __SSE2__
 #include "encoder_sse_base.h"
+#include "encoder_length.h"
 
 void RapidYenc::encoder_sse2_init() {
 	_do_encode = &do_encode_simd< do_encode_sse<ISA_LEVEL_SSE2> >;
+	_do_encode_batch = &do_encode_batch_simd< do_encode_sse<ISA_LEVEL_SSE2> >;
+	_do_encode_iov = &do_encode_iov_simd< do_encode_sse<ISA_LEVEL_SSE2> >;
 	encoder_sse_lut<ISA_LEVEL_SSE2>();
+	encoder_set_length_funcs();
 	_encode_isa = ISA_LEVEL_SSE2;
 }
 #else
@@ -28,6 +28,7 @@ static struct {
 
 template<enum YEncDecIsaLevel use_isa>
 static void encoder_sse_lut() {
+	if(lookups) return; // already set up, if the kernel was re-selected
 	ALIGN_ALLOC(lookups, sizeof(*lookups), 16);
 	for(int i=0; i<256; i++) {
 		int k = i;
@@ -5,10 +5,14 @@
 // requires PSHUFB (SSSE3) instruction, but will use POPCNT (SSE4.2 (or AMD's ABM, but Phenom doesn't support SSSE3 so doesn't matter)) if available (these only seem to give minor speedups, so considered optional)
 #ifdef __SSSE3__
 #include "encoder_sse_base.h"
+#include "encoder_length.h"
 
 void RapidYenc::encoder_ssse3_init() {
 	_do_encode = &do_encode_simd< do_encode_sse<ISA_LEVEL_SSSE3> >;
+	_do_encode_batch = &do_encode_batch_simd< do_encode_sse<ISA_LEVEL_SSSE3> >;
+	_do_encode_iov = &do_encode_iov_simd< do_encode_sse<ISA_LEVEL_SSSE3> >;
 	encoder_sse_lut<ISA_LEVEL_SSSE3>();
+	encoder_set_length_funcs();
 	_encode_isa = ISA_LEVEL_SSSE3;
 }
 #else
@@ -0,0 +1,155 @@
+#include "common.h"
+#include "encoder_common.h"
+
+#ifdef __ARM_FEATURE_SVE2
+#include "encoder.h"
+
+
+static HEDLEY_ALWAYS_INLINE void encode_eol_handle_pre(const uint8_t* HEDLEY_RESTRICT _src, long& inpos, uint8_t*& outp, long& col, long lineSizeOffset) {
+	uint8_t c = _src[inpos++];
+	if(HEDLEY_UNLIKELY(RapidYenc::escapedLUT[c] && c != '.'-42)) {
+		memcpy(outp, &RapidYenc::escapedLUT[c], sizeof(uint16_t));
+		outp += 2;
+	} else {
+		*(outp++) = c + 42;
+	}
+	
+	c = _src[inpos++];
+	if(LIKELIHOOD(0.0273, RapidYenc::escapedLUT[c]!=0)) {
+		uint32_t w = UINT32_16_PACK(UINT16_PACK('\r', '\n'), (uint32_t)RapidYenc::escapedLUT[c]);
+		memcpy(outp, &w, sizeof(w));
+		outp += 4;
+		col = lineSizeOffset + 2;
+	} else {
+		uint32_t w = UINT32_PACK('\r', '\n', (uint32_t)(c+42), 0);
+		memcpy(outp, &w, sizeof(w));
+		outp += 3;
+		col = lineSizeOffset + 1;
+	}
+}
+
+namespace RapidYenc {
+
+HEDLEY_ALWAYS_INLINE void do_encode_sve2(int line_size, int* colOffset, const uint8_t* HEDLEY_RESTRICT srcEnd, uint8_t* HEDLEY_RESTRICT& dest, size_t& len) {
+	const long vl = (long)svcntb();
+	
+	// offset position to enable simpler loop condition checking
+	const long INPUT_OFFSET = vl + 1; // EOL handling reads the last char of the line + first char of the next, which can be one past the vector
+	if((long)len <= INPUT_OFFSET) return;
+	
+	uint8_t *outp = dest;
+	long inpos = -(long)len;
+	long lineSizeOffset = -line_size +1;
+	long col = *colOffset - line_size +1;
+	
+	inpos += INPUT_OFFSET;
+	const uint8_t* _src = srcEnd - INPUT_OFFSET;
+	
+	if (HEDLEY_LIKELY(col == -line_size+1)) {
+		uint8_t c = _src[inpos++];
+		if (LIKELIHOOD(0.0273, escapedLUT[c] != 0)) {
+			memcpy(outp, escapedLUT + c, 2);
+			outp += 2;
+			col += 2;
+		} else {
+			*(outp++) = c + 42;
+			col += 1;
+		}
+	}
+	if(HEDLEY_UNLIKELY(col >= 0)) {
+		if(col == 0)
+			encode_eol_handle_pre(_src, inpos, outp, col, lineSizeOffset);
+		else {
+			uint8_t c = _src[inpos++];
+			if(LIKELIHOOD(0.0273, escapedLUT[c]!=0)) {
+				uint32_t v = UINT32_16_PACK(UINT16_PACK('\r', '\n'), (uint32_t)escapedLUT[c]);
+				memcpy(outp, &v, sizeof(v));
+				outp += 4;
+				col = 2-line_size + 1;
+			} else {
+				uint32_t v = UINT32_PACK('\r', '\n', (uint32_t)(c+42), 0);
+				memcpy(outp, &v, sizeof(v));
+				outp += 3;
+				col = 2-line_size;
+			}
+		}
+	}
+	
+	const svbool_t pg = svptrue_b8();
+	// MATCH compares against every byte in the same 128-bit segment, so the four chars needing escaping are repeated to fill it
+	const svuint8_t ESC_CHARS = svdupq_n_u8(
+		'\0','\r','\n','=', '\0','\r','\n','=', '\0','\r','\n','=', '\0','\r','\n','='
+	);
+	const svuint8_t EQ_CHARS = svdup_n_u8('=');
+	
+	while(inpos < 0) {
+		svuint8_t data = svadd_n_u8_x(pg, svld1_u8(pg, _src + inpos), 42);
+		svbool_t cmp = svmatch_u8(pg, data, ESC_CHARS);
+		long count = (long)svcntp_b8(pg, cmp);
+		
+		if(HEDLEY_LIKELY(count == 0)) {
+			svst1_u8(pg, outp, data);
+		} else {
+			data = svadd_n_u8_m(cmp, data, 64);
+			if(count == 1) {
+				// split the store around the single escaped char
+				svbool_t before = svbrkb_b_z(pg, cmp);
+				svst1_u8(before, outp, data);
+				outp[svcntp_b8(pg, before)] = '=';
+				svst1_u8(svnot_b_z(pg, before), outp+1, data);
+			} else {
+				// interleave '=' before every char, then drop those not preceding an escaped char
+				svcompact_store_u8(
+					svcompact_store_u8(outp, svzip1_b8(cmp, pg), svzip1_u8(EQ_CHARS, data)),
+					svzip2_b8(cmp, pg), svzip2_u8(EQ_CHARS, data)
+				);
+			}
+		}
+		
+		long outputBytes = vl + count;
+		outp += outputBytes;
+		col += outputBytes;
+		inpos += vl;
+		
+		if(HEDLEY_UNLIKELY(col >= 0)) {
+			// line is full; revert to the start of the vector and work out how many chars fit on the line
+			// this is rare enough (and the lookup cheap enough) that doing it without vectors is fine
+			outp -= outputBytes;
+			col -= outputBytes;
+			inpos -= vl;
+			while(col < 0) {
+				uint8_t c = _src[inpos];
+				if(LIKELIHOOD(0.9, escapeLUT[c] != 0)) {
+					*(outp++) = escapeLUT[c];
+					col++;
+				} else {
+					// if an escaped char doesn't fit, it becomes the last char of the line (leaving the line one char longer)
+					if(col == -1) break;
+					outp[0] = '=';
+					outp[1] = c + 42+64;
+					outp += 2;
+					col += 2;
+				}
+				inpos++;
+			}
+			encode_eol_handle_pre(_src, inpos, outp, col, lineSizeOffset);
+		}
+	}
+	
+	*colOffset = col + line_size -1;
+	dest = outp;
+	len = -(inpos - INPUT_OFFSET);
+}
+} // namespace
+
+void RapidYenc::encoder_sve2_init() {
+	_do_encode = &do_encode_simd<do_encode_sve2>;
+	_do_encode_batch = &do_encode_batch_simd<do_encode_sve2>;
+	_do_encode_iov = &do_encode_iov_simd<do_encode_sve2>;
+	_encode_isa = ISA_LEVEL_SVE2;
+}
+#else
+void RapidYenc::encoder_sve2_init() {
+	encoder_neon_init();
+}
+#endif /* defined(__ARM_FEATURE_SVE2) */
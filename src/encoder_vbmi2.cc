@@ -10,17 +10,25 @@ const bool RapidYenc::encoder_has_avx10 = false;
 #if defined(__AVX512VL__) && defined(__AVX512VBMI2__) && defined(__AVX512BW__)
 # ifndef YENC_DISABLE_AVX256
 #  include "encoder_avx_base.h"
+#  include "encoder_length.h"
 
 void RapidYenc::encoder_vbmi2_init() {
 	_do_encode = &do_encode_simd< do_encode_avx2<ISA_LEVEL_VBMI2> >;
+	_do_encode_batch = &do_encode_batch_simd< do_encode_avx2<ISA_LEVEL_VBMI2> >;
+	_do_encode_iov = &do_encode_iov_simd< do_encode_avx2<ISA_LEVEL_VBMI2> >;
 	encoder_avx2_lut<ISA_LEVEL_VBMI2>();
+	encoder_set_length_funcs();
 	_encode_isa = ISA_LEVEL_VBMI2;
 }
 # else
 #  include "encoder_sse_base.h"
+#  include "encoder_length.h"
 void RapidYenc::encoder_vbmi2_init() {
 	_do_encode = &do_encode_simd< do_encode_sse<ISA_LEVEL_VBMI2> >;
+	_do_encode_batch = &do_encode_batch_simd< do_encode_sse<ISA_LEVEL_VBMI2> >;
+	_do_encode_iov = &do_encode_iov_simd< do_encode_sse<ISA_LEVEL_VBMI2> >;
 	encoder_sse_lut<ISA_LEVEL_VBMI2>();
+	encoder_set_length_funcs();
 	_encode_isa = ISA_LEVEL_VBMI2;
 }
 # endif
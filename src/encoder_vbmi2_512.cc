@@ -0,0 +1,138 @@
+#include "common.h"
+#include "encoder_common.h"
+
+// full 512-bit variant of the VBMI2 encoder; 64 bytes are processed at a time, using 64-bit masks
+#if defined(__AVX512VL__) && defined(__AVX512VBMI2__) && defined(__AVX512BW__) && (defined(__EVEX512__) || !(defined(__AVX10_1__) || defined(__EVEX256__))) && !defined(YENC_DISABLE_AVX256)
+#include "encoder_avx_base.h"
+#include "encoder_length.h"
+#define ZMM_SIZE 64
+
+namespace RapidYenc {
+
+// the expand mask (set bits are where data goes, clear bits are where '=' goes) for 32 characters, given which of them need escaping
+// each char is given two bits (data + '='), of which the '=' bit is cleared for unescaped chars, then the remaining bits are packed together
+static HEDLEY_ALWAYS_INLINE uint64_t encode_expand_mask32(uint32_t escMask) {
+	uint64_t used = ~_pdep_u64(~escMask, 0x5555555555555555ULL);
+	return _pext_u64(used ^ 0x5555555555555555ULL, used);
+}
+
+HEDLEY_ALWAYS_INLINE void do_encode_avx512(int line_size, int* colOffset, const uint8_t* HEDLEY_RESTRICT srcEnd, uint8_t* HEDLEY_RESTRICT& dest, size_t& len) {
+	// offset position to enable simpler loop condition checking
+	const int INPUT_OFFSET = ZMM_SIZE + 1; // EOL handling reads the last char of the line + first char of the next, which can be one past the vector
+	if(len <= INPUT_OFFSET || line_size < 16) return;
+	
+	uint8_t *p = dest; // destination pointer
+	intptr_t i = -(intptr_t)len; // input position
+	intptr_t lineSizeOffset = -line_size +1; // -1 because we want to stop one char before the end to handle the last char differently
+	intptr_t col = *colOffset + lineSizeOffset;
+	
+	i += INPUT_OFFSET;
+	const uint8_t* es = srcEnd - INPUT_OFFSET;
+	
+	if(HEDLEY_UNLIKELY(col >= 0)) {
+		uint8_t c = es[i++];
+		if(col == 0) {
+			// last char
+			uint32_t eolChar = lookupsVBMI2->eolLastChar[c];
+			memcpy(p, &eolChar, sizeof(eolChar));
+			p += 3 + (uintptr_t)(eolChar>>27);
+			col = lineSizeOffset;
+		} else {
+			// line overflowed, insert a newline
+			if (LIKELIHOOD(0.0273, escapedLUT[c]!=0)) {
+				uint32_t w = UINT32_16_PACK(UINT16_PACK('\r', '\n'), (uint32_t)escapedLUT[c]);
+				memcpy(p, &w, sizeof(w));
+				p += 4;
+				col = 2-line_size + 1;
+			} else {
+				uint32_t w = UINT32_PACK('\r', '\n', (uint32_t)(c+42), 0);
+				memcpy(p, &w, sizeof(w));
+				p += 3;
+				col = 2-line_size;
+			}
+		}
+	}
+	if (HEDLEY_LIKELY(col == lineSizeOffset)) {
+		// first char of the line
+		uint8_t c = es[i++];
+		if (LIKELIHOOD(0.0273, escapedLUT[c] != 0)) {
+			memcpy(p, escapedLUT + c, 2);
+			p += 2;
+			col += 2;
+		} else {
+			*(p++) = c + 42;
+			col += 1;
+		}
+	}
+	
+	// as the first char of each line is handled separately, only NUL/CR/LF/'=' need to be found here; the same lookup as the 256-bit encoder is used
+	const __m512i escLUT = _mm512_maskz_broadcast_i32x4(0xffff, _mm_set_epi8(
+		'\0'-42,-42,'\r'-42,'.'-42,'='-42,'\0'-42,'\t'-42,'\n'-42,-42,-42,'\r'-42,-42,'='-42,' '-42,-42,'\n'-42
+	));
+	while(i < 0) {
+		__m512i data = _mm512_loadu_si512(es + i);
+		uint64_t mask = _mm512_cmpeq_epi8_mask(_mm512_shuffle_epi8(escLUT, _mm512_abs_epi8(data)), data);
+		data = _mm512_add_epi8(data, _mm512_set1_epi8(42));
+		data = _mm512_mask_add_epi8(data, mask, data, _mm512_set1_epi8(64));
+		
+		unsigned int outputBytes = ZMM_SIZE + (unsigned int)_mm_popcnt_u64(mask);
+		// expand each half separately, as each can grow to 64 bytes
+		_mm512_storeu_si512(p, _mm512_mask_expand_epi8(_mm512_set1_epi8('='), encode_expand_mask32((uint32_t)mask), data));
+		_mm512_storeu_si512(p + 32 + popcnt32((uint32_t)mask), _mm512_mask_expand_epi8(
+			_mm512_set1_epi8('='), encode_expand_mask32((uint32_t)(mask >> 32)), _mm512_maskz_shuffle_i64x2(0xf, data, data, _MM_SHUFFLE(3,2,3,2))
+		));
+		col += outputBytes;
+		if(col < 0) {
+			p += outputBytes;
+			i += ZMM_SIZE;
+			continue;
+		}
+		
+		// line is full; find how many chars fit in the remaining space
+		// escaped chars are rare, so a good first guess is to assume that those in the first `room` chars are the only ones that fit, which only needs correcting if there are more just before the end of the line
+		unsigned int room = outputBytes - (unsigned int)col;
+		unsigned int chars = room - (unsigned int)_mm_popcnt_u64(_bzhi_u64(mask, room < ZMM_SIZE ? room : ZMM_SIZE));
+		if(chars > ZMM_SIZE) chars = ZMM_SIZE;
+		while(HEDLEY_UNLIKELY(chars < ZMM_SIZE && chars + 1 + _mm_popcnt_u64(_bzhi_u64(mask, chars+1)) <= room))
+			chars++;
+		// if an escaped char doesn't fit, it becomes the last char of the line (leaving the line one char longer)
+		p += chars + (unsigned int)_mm_popcnt_u64(_bzhi_u64(mask, chars));
+		i += chars;
+		
+		// last char of the line + EOL, then the first char of the next line
+		uint32_t eolChar = lookupsVBMI2->eolLastChar[es[i]];
+		memcpy(p, &eolChar, sizeof(eolChar));
+		p += 3 + (uintptr_t)(eolChar>>27);
+		uint8_t c = es[i+1];
+		i += 2;
+		if (LIKELIHOOD(0.0273, escapedLUT[c] != 0)) {
+			memcpy(p, escapedLUT + c, 2);
+			p += 2;
+			col = lineSizeOffset + 2;
+		} else {
+			*(p++) = c + 42;
+			col = lineSizeOffset + 1;
+		}
+	}
+	
+	_mm256_zeroupper();
+	
+	*colOffset = (int)(col + line_size -1);
+	dest = p;
+	len = -(i - INPUT_OFFSET);
+}
+} // namespace
+
+void RapidYenc::encoder_vbmi2_512_init() {
+	_do_encode = &do_encode_simd<do_encode_avx512>;
+	_do_encode_batch = &do_encode_batch_simd<do_encode_avx512>;
+	_do_encode_iov = &do_encode_iov_simd<do_encode_avx512>;
+	encoder_avx2_lut<ISA_LEVEL_VBMI2>();
+	encoder_set_length_funcs();
+	_encode_isa = ISA_LEVEL_VBMI2 | ISA_FEATURE_EVEX512;
+}
+#else
+void RapidYenc::encoder_vbmi2_512_init() {
+	encoder_vbmi2_init();
+}
+#endif
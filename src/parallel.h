@@ -0,0 +1,31 @@
+#ifndef __YENC_PARALLEL_H
+#define __YENC_PARALLEL_H
+
+#include <stddef.h> // for size_t
+
+// inputs are split into chunks no smaller than this, as splitting has some overhead
+#define PARALLEL_MIN_CHUNK 65536
+
+namespace RapidYenc {
+
+// callbacks for running tasks across threads; these mirror RapidYencTask/RapidYencTaskRunner in rapidyenc.h
+typedef void (*task_func)(void* data, size_t index);
+typedef void (*task_runner)(void* pool, task_func task, void* data, size_t count);
+
+// runs `count` tasks via the supplied runner, or serially on the current thread if none was given
+static inline void run_tasks(task_runner runner, void* pool, task_func task, void* data, size_t count) {
+	if(runner)
+		runner(pool, task, data, count);
+	else
+		for(size_t i=0; i<count; i++)
+			task(data, i);
+}
+
+// a piece of non-contiguous input, used by the encoder and decoder; this mirrors RapidYencIovec in rapidyenc.h
+struct iovec_segment {
+	const void* base;
+	size_t len;
+};
+
+}
+#endif
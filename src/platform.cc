@@ -14,6 +14,9 @@
 #    include <asm/hwcap.h>
 #   endif
 #  endif
+#  if defined(__linux__) && __has_include(<sys/prctl.h>)
+#   include <sys/prctl.h>
+#  endif
 #  if defined(__ANDROID__) && __has_include(<cpu-features.h>)
 #   include <cpu-features.h>
 #  endif
@@ -56,6 +59,36 @@ bool RapidYenc::cpu_supports_neon() {
 	return false;
 # endif
 }
+
+bool RapidYenc::cpu_supports_sve2() {
+# if defined(__aarch64__) && defined(AT_HWCAP2)
+#  ifndef HWCAP2_SVE2
+#   define HWCAP2_SVE2 (1 << 1)
+#  endif
+#  if defined(__FreeBSD__) || defined(__OpenBSD__)
+	unsigned long supported = 0;
+	elf_aux_info(AT_HWCAP2, &supported, sizeof(supported));
+	return supported & HWCAP2_SVE2;
+#  else
+	return getauxval(AT_HWCAP2) & HWCAP2_SVE2;
+#  endif
+# elif defined(_WIN32) && defined(PF_ARM_SVE2_INSTRUCTIONS_AVAILABLE)
+	return IsProcessorFeaturePresent(PF_ARM_SVE2_INSTRUCTIONS_AVAILABLE);
+# else
+	return false; // Apple CPUs don't support SVE
+# endif
+}
+
+// querying the length directly requires SVE instructions, which this file isn't compiled with
+size_t RapidYenc::cpu_sve_length() {
+# if defined(__aarch64__) && defined(PR_SVE_GET_VL)
+	int vl = prctl(PR_SVE_GET_VL);
+	if(vl < 0) return 0;
+	return vl & PR_SVE_VL_LEN_MASK;
+# else
+	return 0;
+# endif
+}
 #endif
 
 
@@ -142,15 +175,22 @@ int RapidYenc::cpu_supports_isa() {
 								if((cpuInfo2[1] & 0xff) >= 1 && ( // minimum AVX10.1
 									cpuInfo2[1] & 0x20000 // AVX10/256 (AVX10/128 is now invalid)
 								)) {
-									if(cpuInfo2[1] & 0x40000) ret |= ISA_FEATURE_EVEX512;
+									if(cpuInfo2[1] & 0x40000) ret |= ISA_FEATURE_EVEX512 | ISA_FEATURE_FAST512;
 									return ret | ISA_LEVEL_VBMI2;
 								}
 							}
 							
 							if((cpuInfo[1] & 0xC0010000) == 0xC0010000) { // AVX512BW + AVX512VL + AVX512F
 								ret |= ISA_FEATURE_EVEX512;
-								if(cpuInfo[2] & 0x40)
+								if(cpuInfo[2] & 0x40) {
+									// Ice Lake, Tiger Lake and Rocket Lake drop their clock speed when running 512-bit instructions, which can negate the benefit of wider vectors
+									if(!(family == 6 && (model == 0x6A || model == 0x6C || model == 0x7D || model == 0x7E || model == 0x8C || model == 0x8D || model == 0xA7)))
+										ret |= ISA_FEATURE_FAST512;
+									// Intel cores only have 512-bit shuffle units on one port, whereas AMD Zen5 has full-width units on all ports
+									if(family >= 0xbf) // AMD family 1Ah+
+										ret |= ISA_FEATURE_FULL512;
 									return ret | ISA_LEVEL_VBMI2;
+								}
 								return ret | ISA_LEVEL_AVX3;
 							}
 						}
@@ -178,6 +218,9 @@ int RapidYenc::cpu_supports_crc_isa() {
 				int cpuInfo[4];
 				_cpuidX(cpuInfo, 7, 0);
 				if((cpuInfo[1] & 0x20) == 0x20 && (cpuInfo[2] & 0x400) == 0x400) { // AVX2 + VPCLMULQDQ
+					// AVX512F is also enumerated by AVX10 if it supports 512-bit vectors
+					if((xcr & 0xE0) == 0xE0 && (cpuInfo[1] & 0x10000)) // AVX512 XSTATE + AVX512F
+						return 3;
 					return 2;
 				}
 			}
@@ -187,6 +230,12 @@ int RapidYenc::cpu_supports_crc_isa() {
 	return 0;
 }
 
+bool RapidYenc::cpu_supports_crc32c() {
+	int flags[4];
+	_cpuid1(flags);
+	return (flags[2] & 0x100002) == 0x100002; // SSE4.2 + CLMUL
+}
+
 #endif // PLATFORM_X86
 
 #ifdef __riscv
@@ -11,13 +11,18 @@ static const char* kernel_to_str(int k) {
 	if(k == RYKERN_AVX) return "AVX";
 	if(k == RYKERN_AVX2) return "AVX2";
 	if(k == RYKERN_VBMI2) return "VBMI2";
+	if(k == RYKERN_VBMI2_512) return "VBMI2 (512-bit)";
 	if(k == RYKERN_NEON) return "NEON";
+	if(k == RYKERN_SVE2) return "SVE2";
 	if(k == RYKERN_PCLMUL) return "PCLMUL";
 	if(k == RYKERN_VPCLMUL) return "VPCLMUL";
+	if(k == RYKERN_VPCLMUL512) return "VPCLMUL (512-bit)";
+	if(k == RYKERN_SSE42) return "SSE4.2";
 	if(k == RYKERN_ARMCRC) return "ARM-CRC";
 	if(k == RYKERN_RVV) return "RVV";
 	if(k == RYKERN_ARMPMULL) return "ARM-CRC + PMULL";
 	if(k == RYKERN_ZBC) return "Zbkc";
+	if(k == RYKERN_ZVBC) return "Zvbc";
 	return "unknown";
 }
 #define ARTICLE_SIZE 768000ULL
@@ -48,6 +53,57 @@ int main(int, char**) {
 		double speed = ARTICLE_SIZE * REPETITIONS;
 		speed = speed / us / 1.048576;
 		std::cerr << "Encode (" << kernel_to_str(kernel) << "): " << speed << " MB/s" << std::endl;
+		
+		// compare against the kernel using the other vector width (VBMI2 512/256-bit, SVE2/NEON), if the CPU supports it
+		static const int alt_kernels[][2] = {{RYKERN_VBMI2_512, RYKERN_VBMI2}, {RYKERN_SVE2, RYKERN_NEON}};
+		for(auto& alts : alt_kernels) for(int other : alts) {
+			if(kernel != alts[0] && kernel != alts[1]) break;
+			if(other == kernel || !rapidyenc_encode_set_kernel(other)) continue;
+			start = std::chrono::high_resolution_clock::now();
+			for(int i=0; i<REPETITIONS; i++) {
+				rapidyenc_encode(data.data(), article.data(), ARTICLE_SIZE);
+			}
+			stop = std::chrono::high_resolution_clock::now();
+			us = std::chrono::duration_cast<std::chrono::microseconds>(stop - start).count();
+			speed = ARTICLE_SIZE * REPETITIONS;
+			speed = speed / us / 1.048576;
+			std::cerr << "Encode (" << kernel_to_str(other) << "): " << speed << " MB/s" << std::endl;
+		}
+		rapidyenc_encode_set_kernel(kernel);
+		
+		// many small articles: individual calls vs batch
+		static const size_t small_sizes[] = {256, 1024, 4096};
+		for(size_t small_size : small_sizes) {
+			// worst case output is about twice the input, so fit as many articles as the output buffer allows
+			size_t max_out = rapidyenc_encode_max_length(small_size, 128);
+			size_t num_jobs = article.size() / max_out;
+			std::vector<RapidYencEncodeJob> jobs(num_jobs);
+			for(size_t j=0; j<num_jobs; j++) {
+				jobs[j].src = data.data() + j*small_size;
+				jobs[j].dest = article.data() + j*max_out;
+				jobs[j].src_length = small_size;
+			}
+			
+			start = std::chrono::high_resolution_clock::now();
+			for(int i=0; i<REPETITIONS; i++) {
+				for(auto& job : jobs)
+					job.dest_length = rapidyenc_encode(job.src, job.dest, job.src_length);
+			}
+			stop = std::chrono::high_resolution_clock::now();
+			us = std::chrono::duration_cast<std::chrono::microseconds>(stop - start).count();
+			double speed_single = num_jobs * small_size * REPETITIONS;
+			speed_single = speed_single / us / 1.048576;
+			
+			start = std::chrono::high_resolution_clock::now();
+			for(int i=0; i<REPETITIONS; i++) {
+				rapidyenc_encode_batch(128, jobs.data(), num_jobs);
+			}
+			stop = std::chrono::high_resolution_clock::now();
+			us = std::chrono::duration_cast<std::chrono::microseconds>(stop - start).count();
+			speed = num_jobs * small_size * REPETITIONS;
+			speed = speed / us / 1.048576;
+			std::cerr << "Encode " << small_size << "B articles: " << speed_single << " MB/s individually, " << speed << " MB/s batched" << std::endl;
+		}
 	}
 #else
 	{
@@ -89,6 +145,23 @@ int main(int, char**) {
 		double speed = article_length * REPETITIONS;
 		speed = speed / us / 1.048576;
 		std::cerr << "Decode (" << kernel_to_str(kernel) << "): " << speed << " MB/s" << std::endl;
+		
+		// compare against the kernel using the other vector width (VBMI2 512/256-bit, SVE2/NEON), if the CPU supports it
+		static const int alt_kernels[][2] = {{RYKERN_VBMI2_512, RYKERN_VBMI2}, {RYKERN_SVE2, RYKERN_NEON}};
+		for(auto& alts : alt_kernels) for(int other : alts) {
+			if(kernel != alts[0] && kernel != alts[1]) break;
+			if(other == kernel || !rapidyenc_decode_set_kernel(other)) continue;
+			start = std::chrono::high_resolution_clock::now();
+			for(int i=0; i<REPETITIONS; i++) {
+				rapidyenc_decode(article.data(), data.data(), article_length);
+			}
+			stop = std::chrono::high_resolution_clock::now();
+			us = std::chrono::duration_cast<std::chrono::microseconds>(stop - start).count();
+			speed = article_length * REPETITIONS;
+			speed = speed / us / 1.048576;
+			std::cerr << "Decode (" << kernel_to_str(other) << "): " << speed << " MB/s" << std::endl;
+		}
+		rapidyenc_decode_set_kernel(kernel);
 	}
 #endif
 	
@@ -123,6 +196,27 @@ int main(int, char**) {
 		speed = SINGLE_OP_NUM * REPETITIONS;
 		speed = speed / us;
 		std::cerr << "CRC32 256^n: " << speed << " Mop/s" << std::endl;
+		
+		start = std::chrono::high_resolution_clock::now();
+		for(int i=0; i<REPETITIONS; i++)
+			rapidyenc_crc_256pow_many(rnd_n.data(), rnd_out.data(), SINGLE_OP_NUM);
+		stop = std::chrono::high_resolution_clock::now();
+		us = std::chrono::duration_cast<std::chrono::microseconds>(stop - start).count();
+		speed = SINGLE_OP_NUM * REPETITIONS;
+		speed = speed / us;
+		std::cerr << "CRC32 256^n (many): " << speed << " Mop/s" << std::endl;
+	}
+	{
+		auto kernel = rapidyenc_crc32c_kernel();
+		auto start = std::chrono::high_resolution_clock::now();
+		for(int i=0; i<REPETITIONS; i++) {
+			rapidyenc_crc32c(data.data(), ARTICLE_SIZE, 0);
+		}
+		auto stop = std::chrono::high_resolution_clock::now();
+		float us = std::chrono::duration_cast<std::chrono::microseconds>(stop - start).count();
+		double speed = ARTICLE_SIZE * REPETITIONS;
+		speed = speed / us / 1.048576;
+		std::cerr << "CRC32C (" << kernel_to_str(kernel) << "): " << speed << " MB/s" << std::endl;
 	}
 #endif
 	
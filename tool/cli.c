@@ -85,9 +85,10 @@ int main(int argc, char **argv) {
 				has_error = 1;
 				break;
 			}
-			size_t out_len = rapidyenc_encode_ex(LINE_SIZE, &column, data, output, read, eof);
 #ifndef RAPIDYENC_DISABLE_CRC
-			crc = rapidyenc_crc(data, read, crc);
+			size_t out_len = rapidyenc_encode_crc_ex(LINE_SIZE, &column, data, output, read, eof, &crc);
+#else
+			size_t out_len = rapidyenc_encode_ex(LINE_SIZE, &column, data, output, read, eof);
 #endif
 			if(fwrite(output, 1, out_len, outfile) != out_len) {
 				fprintf(stderr, "error writing output\n");
@@ -119,11 +120,12 @@ int main(int argc, char **argv) {
 				has_error = 1;
 				break;
 			}
-			ended = rapidyenc_decode_incremental((const void**)&in_ptr, &out_ptr, read, &state);
-			size_t out_len = (uintptr_t)out_ptr - (uintptr_t)data;
 #ifndef RAPIDYENC_DISABLE_CRC
-			crc = rapidyenc_crc(data, out_len, crc);
+			ended = rapidyenc_decode_incremental_crc((const void**)&in_ptr, &out_ptr, read, &state, &crc);
+#else
+			ended = rapidyenc_decode_incremental((const void**)&in_ptr, &out_ptr, read, &state);
 #endif
+			size_t out_len = (uintptr_t)out_ptr - (uintptr_t)data;
 			if(fwrite(data, 1, out_len, outfile) != out_len) {
 				fprintf(stderr, "error writing output\n");
 				has_error = 1;